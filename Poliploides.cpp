@@ -2,6 +2,9 @@
 #include <fstream>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <cstring>
+#include <cstdlib>
 #include <sstream>
 #include <stdexcept>
 #include <algorithm>
@@ -11,6 +14,40 @@
 #include <matplot/matplot.h>
 #include <queue>
 #include <set>
+#include <cstdint>
+#include <new>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <unordered_map>
+#include <deque>
+#include <memory>
+#include <array>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cmath>
+#include <filesystem>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+    #include <immintrin.h>
+#endif
+
+#if defined(POLIPLOIDES_MPI)
+    #include <mpi.h>
+#endif
+
+#if defined(_WIN32)
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
 
 using namespace std;
 using namespace matplot;
@@ -52,19 +89,155 @@ struct Job {
     }
 };
 
+/*
+ GeneDecode
+ Operacion que representa un gen dentro del cromosoma de una politica
+ 
+ jobId: Trabajo al que pertenece la operacion
+ opId: Operacion (indice en las matrices de tiempo/energia)
+ */
+struct GeneDecode {
+    int32_t jobId;
+    int32_t opId;
+};
+
+/*
+ AlignedAllocator
+ Asignador para contenedores estandar que alinea el bloque reservado
+ a Alignment bytes (por ejemplo, a una linea de cache)
+ */
+template <typename T, size_t Alignment>
+struct AlignedAllocator {
+    using value_type = T;
+    
+    template <typename U>
+    struct rebind { using other = AlignedAllocator<U, Alignment>; };
+    
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+    
+    T* allocate(size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), align_val_t(Alignment)));
+    }
+    void deallocate(T* p, size_t) {
+        ::operator delete(p, align_val_t(Alignment));
+    }
+    
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const { return false; }
+};
+
+/*
+ CostMatrix
+ Matriz densa [operacion][maquina] almacenada en un unico bloque contiguo
+ 
+ Cada fila se rellena hasta un multiplo de 64 bytes, de modo que todas
+ las filas empiezan alineadas a linea de cache. matrix[op][m] devuelve
+ directamente el valor sin pasar por vectores de filas independientes.
+ 
+ rows: Numero de filas (operaciones)
+ cols: Numero de columnas utiles (maquinas)
+ stride: Distancia en elementos entre el inicio de dos filas consecutivas
+ */
+class CostMatrix {
+public:
+    static const int ROW_ALIGNMENT = 64;
+    
+    CostMatrix() : rows(0), cols(0), stride(0) {}
+    
+    /*
+     Redimensiona la matriz a numRows x numCols, con todos los valores en 0
+     */
+    void resize(int numRows, int numCols) {
+        rows = numRows;
+        cols = numCols;
+        stride = paddedStride(numCols);
+        values.assign(size_t(rows) * stride, 0.0);
+    }
+    
+    /*
+     Agrega una fila al final de la matriz; la primera fila fija el numero de columnas
+     
+     row: Valores de la fila
+     count: Numero de valores (debe coincidir con cols salvo en la primera fila)
+     */
+    void appendRow(const double* row, int count) {
+        if (rows == 0) {
+            cols = count;
+            stride = paddedStride(count);
+        }
+        values.resize(size_t(rows + 1) * stride, 0.0);
+        copy(row, row + count, values.data() + size_t(rows) * stride);
+        rows++;
+    }
+    
+    double* operator[](int row) { return values.data() + size_t(row) * stride; }
+    const double* operator[](int row) const { return values.data() + size_t(row) * stride; }
+    
+    int numRows() const { return rows; }
+    int numCols() const { return cols; }
+    int rowStride() const { return stride; }
+    
+private:
+    int rows;
+    int cols;
+    int stride;
+    vector<double, AlignedAllocator<double, ROW_ALIGNMENT>> values;
+    
+    static int paddedStride(int numCols) {
+        const int perLine = ROW_ALIGNMENT / sizeof(double);
+        return (numCols + perLine - 1) / perLine * perLine;
+    }
+};
+
+/*
+ ScenarioData
+ Contiene todos los datos de un escenario cargado desde archivo
+ 
+ numOperations: Numero de operaciones (filas de las matrices), inferido del archivo
+ numMachines: Numero de maquinas (columnas de las matrices), inferido del archivo
+ numJobs: Numero de trabajos leidos
+ totalOperations: Suma de operaciones de todos los trabajos (tamaño de cada cromosoma)
+ processingTime: Tiempo de procesamiento [operacion][maquina]
+ energyCost: Consumo energetico [operacion][maquina]
+ decodeTables: Tabla de decodificacion de genes de cada politica, indexada
+               igual que policyNames (decodeTables[politica][gen])
+ */
 struct ScenarioData {
     int numOperations;
     int numMachines;
     int numJobs;
+    int totalOperations;
     
-    vector<vector<double>> processingTime;
-    vector<vector<double>> energyCost;
+    CostMatrix processingTime;
+    CostMatrix energyCost;
     vector<Job> jobs;
-    map<string,vector<pair<Job,Operation>>> chromosomeMapping;
+    vector<vector<GeneDecode>> decodeTables;
     
-    ScenarioData() : numOperations(5), numMachines(4), numJobs(0) {}
+    ScenarioData() : numOperations(0), numMachines(0), numJobs(0), totalOperations(0) {}
 };
 
+// Politicas de ordenamiento, en el mismo orden que los cromosomas de cada individuo
+const vector<string> policyNames = {"FIFO", "LTP", "STP", "RRFIFO", "RRLTP", "RRECA"};
+
+// Numero de politicas (y de cromosomas por individuo)
+const int NUM_POLICIES = 6;
+
+// Identificador interno de una politica: su indice en policyNames y en decodeTables
+using PolicyId = uint8_t;
+
+// Un gen guarda la maquina asignada a una operacion, en el rango [1, numMachines].
+// Con genes de 8 bits se admiten hasta 255 maquinas; para escenarios mayores
+// compilar con -DPOLIPLOIDES_WIDE_GENES (genes de 16 bits).
+#if defined(POLIPLOIDES_WIDE_GENES)
+using Gene = uint16_t;
+#else
+using Gene = uint8_t;
+#endif
+
 
 
 /*
@@ -123,6 +296,170 @@ struct JobState {
     JobState() : nextOperationIndex(0), lastOperationEndTime(0.0) {}
 };
 
+/*
+ EvaluationScratch
+ Estado de simulacion reutilizable entre evaluaciones de cromosomas
+ 
+ Se dimensiona una vez por escenario con prepare() y luego cada evaluacion
+ solo reinicia los valores, sin reservar memoria.
+ 
+ machines: Estados de las maquinas
+ jobStates: Estados de los trabajos
+ */
+struct EvaluationScratch {
+    vector<MachineState> machines;
+    vector<JobState> jobStates;
+    
+    void prepare(int numMachines, int numJobs) {
+        machines.resize(numMachines);
+        jobStates.resize(numJobs);
+    }
+    
+    void reset() {
+        fill(machines.begin(), machines.end(), MachineState());
+        fill(jobStates.begin(), jobStates.end(), JobState());
+    }
+};
+
+/*
+ SimulationSnapshot
+ Copia inmutable del estado de maquinas y trabajos en un punto del cromosoma
+ */
+struct SimulationSnapshot {
+    vector<MachineState> machines;
+    vector<JobState> jobStates;
+};
+
+/*
+ SimulationCheckpoints
+ Checkpoints periodicos de la simulacion de un cromosoma
+ 
+ snapshots[k-1] guarda el estado antes de simular el gen k*interval, es decir,
+ despues de los genes [0, k*interval). Los snapshots son inmutables y se
+ comparten entre copias del cromosoma y entre evaluaciones sucesivas, por lo
+ que reutilizar un prefijo solo copia punteros.
+ 
+ interval: Genes entre dos checkpoints consecutivos
+ snapshots: Estados guardados, en orden
+ */
+struct SimulationCheckpoints {
+    int interval;
+    vector<shared_ptr<const SimulationSnapshot>> snapshots;
+    
+    /*
+     Numero de snapshots que siguen siendo validos si el primer gen modificado es firstChangedGene
+     */
+    size_t validBefore(int firstChangedGene) const {
+        return min(snapshots.size(), size_t(firstChangedGene / interval));
+    }
+};
+
+// GENERADOR DE NUMEROS ALEATORIOS
+
+/*
+ RandomEngine
+ Generador xoshiro256** con flujos independientes y reproducibles
+ 
+ Todo el azar del algoritmo sale de generadores creados a partir de una sola
+ semilla. El flujo k empieza 2^128 * k pasos despues del flujo 0 (jump), de
+ modo que los flujos nunca se solapan. Los flujos se asignan a tareas logicas
+ (poblaciones, islas), nunca a hilos, para que el resultado sea el mismo con
+ cualquier numero de hilos. Las distribuciones (nextBelow, nextInt,
+ nextDouble) no dependen de la biblioteca estandar: una misma semilla da los
+ mismos resultados con cualquier compilador.
+ 
+ seed: Semilla del usuario
+ stream: Numero de flujo
+ */
+class RandomEngine {
+public:
+    using result_type = uint64_t;
+    
+    explicit RandomEngine(uint64_t seed = 0, uint64_t stream = 0) {
+        // splitmix64 para expandir la semilla a los 256 bits de estado
+        for (auto& word : state) {
+            seed += 0x9e3779b97f4a7c15ULL;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            word = z ^ (z >> 31);
+        }
+        for (uint64_t i = 0; i < stream; i++) {
+            jump();
+        }
+    }
+    
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return numeric_limits<result_type>::max(); }
+    
+    result_type operator()() {
+        const uint64_t result = rotl(state[1] * 5, 7) * 9;
+        const uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+    
+    /*
+     Avanza el generador 2^128 pasos (inicio del siguiente flujo)
+     */
+    void jump() {
+        static const uint64_t JUMP[] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                                        0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+        uint64_t next[4] = {0, 0, 0, 0};
+        for (uint64_t mask : JUMP) {
+            for (int bit = 0; bit < 64; bit++) {
+                if (mask & (uint64_t(1) << bit)) {
+                    for (int w = 0; w < 4; w++) next[w] ^= state[w];
+                }
+                (*this)();
+            }
+        }
+        memcpy(state, next, sizeof(state));
+    }
+    
+    /*
+     Entero uniforme en [0, bound) sin sesgo (metodo de Lemire)
+     */
+    uint32_t nextBelow(uint32_t bound) {
+        uint64_t product = ((*this)() >> 32) * bound;
+        uint32_t low = uint32_t(product);
+        if (low < bound) {
+            uint32_t threshold = uint32_t(-bound) % bound;
+            while (low < threshold) {
+                product = ((*this)() >> 32) * bound;
+                low = uint32_t(product);
+            }
+        }
+        return uint32_t(product >> 32);
+    }
+    
+    /*
+     Entero uniforme en [minValue, maxValue]
+     */
+    int nextInt(int minValue, int maxValue) {
+        return minValue + int(nextBelow(uint32_t(maxValue - minValue) + 1));
+    }
+    
+    /*
+     Real uniforme en [0, 1) con 53 bits de precision
+     */
+    double nextDouble() {
+        return double((*this)() >> 11) * 0x1.0p-53;
+    }
+    
+private:
+    uint64_t state[4];
+    
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+};
+
 
 void printHeader(const string& headerText, int length){
     #if defined(_WIN32)
@@ -331,48 +668,127 @@ void printTable(const vector<string>& fields, const vector<vector<string>>& valu
     cout << bottomRight << endl;
 }
 
+/*
+ Chromosome
+ Cromosoma de una politica dentro de un individuo poliploide
+ 
+ Los genes no pertenecen al cromosoma: apuntan al genoma del individuo dentro
+ de la arena de su Population. Por eso el cromosoma no se puede copiar por
+ valor (se copiaria el puntero); copyFrom copia los genes y el estado.
+ 
+ policy: Politica del cromosoma
+ genes: Genes del cromosoma (numGenes valores en [1, numMachines])
+ numGenes: Numero de genes (operaciones totales en el escenario)
+ */
 class Chromosome {
 public:
-    string policyName;
-    vector<int> genes;
+    PolicyId policy;
+    Gene* genes;
+    int numGenes;
     double f1; // Makespan
     double f2; // Energia total
     int domLevel; // Nivel de dominancia
     double crowdingDistance; // Distancia de Crowding
+    bool dirty; // true si los genes cambiaron desde la ultima evaluacion
+    int dirtyFrom; // Primer gen modificado desde la ultima evaluacion
+    shared_ptr<const SimulationCheckpoints> checkpoints; // Estados intermedios de la ultima evaluacion
     
-    // Constructor por defecto
-    Chromosome() : policyName("") {
-        f1 = 0.0;
-        f2 = 0.0;
-        domLevel = -1;
-        crowdingDistance = -1;
+    // Constructor por defecto (sin genes)
+    Chromosome() : policy(0), genes(nullptr), numGenes(0) {
+        reset();
+    }
+    
+    // Constructor con politica y genes dentro de un genoma
+    Chromosome(PolicyId policy, Gene* genes, int numGenes) : policy(policy), genes(genes), numGenes(numGenes) {
+        reset();
+    }
+    
+    Chromosome(const Chromosome&) = delete;
+    Chromosome& operator=(const Chromosome&) = delete;
+    Chromosome(Chromosome&&) = default;
+    Chromosome& operator=(Chromosome&&) = default;
+    
+    /*
+     Obtiene el nombre de la politica del cromosoma
+     */
+    const string& getPolicyName() const {
+        return policyNames[policy];
     }
     
-    // Constructor con nombre de politica
-    Chromosome(const string& name) : policyName(name) {
+    /*
+     Deja el estado del cromosoma como el de uno recien creado (sin evaluar)
+     Los genes no se modifican.
+     */
+    void reset() {
         f1 = 0.0;
         f2 = 0.0;
         domLevel = -1;
         crowdingDistance = -1;
+        dirty = true;
+        dirtyFrom = 0;
+        checkpoints.reset();
+    }
+    
+    /*
+     Copia los genes y el estado de otro cromosoma del mismo tamaño
+     
+     other: Cromosoma de origen
+     */
+    void copyFrom(const Chromosome& other) {
+        if (this == &other) return;
+        policy = other.policy;
+        memcpy(genes, other.genes, size_t(numGenes) * sizeof(Gene));
+        f1 = other.f1;
+        f2 = other.f2;
+        domLevel = other.domLevel;
+        crowdingDistance = other.crowdingDistance;
+        dirty = other.dirty;
+        dirtyFrom = other.dirtyFrom;
+        checkpoints = other.checkpoints;
+    }
+    
+    /*
+     Marca el cromosoma como modificado a partir de un gen
+     
+     fromGene: Primer gen que cambio (0 si cambio todo el cromosoma)
+     */
+    void markDirty(int fromGene = 0) {
+        dirtyFrom = dirty ? min(dirtyFrom, fromGene) : fromGene;
+        dirty = true;
+    }
+    
+    /*
+     Marca el cromosoma como evaluado, descartando los checkpoints que
+     quedaron despues del primer gen modificado
+     */
+    void markClean() {
+        if (dirty && checkpoints) {
+            size_t valid = checkpoints->validBefore(dirtyFrom);
+            if (valid == 0) {
+                checkpoints.reset();
+            } else if (valid < checkpoints->snapshots.size()) {
+                auto truncated = make_shared<SimulationCheckpoints>();
+                truncated->interval = checkpoints->interval;
+                truncated->snapshots.assign(checkpoints->snapshots.begin(), checkpoints->snapshots.begin() + valid);
+                checkpoints = truncated;
+            }
+        }
+        dirty = false;
+        dirtyFrom = numeric_limits<int>::max();
     }
     
     /*
      Inicializa el cromosoma con valores aleatorios
      
-     size: Numero de genes (operaciones totales en el escenario)
      minValue: Valor minimo para los genes (tipicamente 1)
      maxValue: Valor maximo para los genes (tipicamente numMachines)
      rng: Generador de numeros aleatorios
      */
-    void initializeRandom(int size, int minValue, int maxValue, mt19937& rng) {
-        genes.clear();
-        genes.reserve(size);
-        
-        uniform_int_distribution<int> dist(minValue, maxValue);
-        
-        for (int i = 0; i < size; i++) {
-            genes.push_back(dist(rng));
+    void initializeRandom(int minValue, int maxValue, RandomEngine& rng) {
+        for (int i = 0; i < numGenes; i++) {
+            genes[i] = Gene(rng.nextInt(minValue, maxValue));
         }
+        markDirty();
     }
     
     /*
@@ -380,17 +796,17 @@ public:
      int: Numero de genes
      */
     int size() const {
-        return genes.size();
+        return numGenes;
     }
     
     /*
      Imprime el cromosoma en formato legible
      */
     void print() const {
-        cout << policyName << ": [";
-        for (size_t i = 0; i < genes.size(); i++) {
-            cout << genes[i];
-            if (i < genes.size() - 1) cout << ", ";
+        cout << getPolicyName() << ": [";
+        for (int i = 0; i < numGenes; i++) {
+            cout << int(genes[i]);
+            if (i < numGenes - 1) cout << ", ";
         }
         cout << "]" << endl;
     }
@@ -408,37 +824,61 @@ public:
  - Cromosoma 4: RRLTP (Round Robin LTP)
  - Cromosoma 5: RRECA (Round Robin Energy Cost Aware)
  
- chromosomes: Vector de 6 cromosomas (tamaño fijo)
- f1: Fitness objetivo 1 - Makespan (tiempo total de finalizacion)
- f2: Fitness objetivo 2 - Consumo energetico total
+ El genoma (los 6 cromosomas) ocupa un bloque contiguo de la arena de la
+ Population a la que pertenece el individuo.
+ 
+ chromosomes: Los 6 cromosomas, en el orden de policyNames
  */
 class Individual {
 public:
-    vector<Chromosome> chromosomes;
+    array<Chromosome, NUM_POLICIES> chromosomes;
+    
+    // Constructor por defecto (sin genoma)
+    Individual() {}
+    
+    /*
+     Construye un individuo sobre un genoma de la arena
+     
+     genome: Inicio del genoma del individuo
+     numGenes: Numero de genes por cromosoma
+     chromosomeStride: Distancia (en genes) entre el inicio de dos cromosomas
+     */
+    Individual(Gene* genome, int numGenes, size_t chromosomeStride) {
+        for (int c = 0; c < NUM_POLICIES; c++) {
+            chromosomes[c] = Chromosome(PolicyId(c), genome + c * chromosomeStride, numGenes);
+        }
+    }
+    
+    /*
+     Copia los genes y el estado de todos los cromosomas de otro individuo
+     */
+    void copyFrom(const Individual& other) {
+        for (int c = 0; c < NUM_POLICIES; c++) {
+            chromosomes[c].copyFrom(other.chromosomes[c]);
+        }
+    }
     
-    // Constructor por defecto
-    Individual() {
-        // Inicializar con 6 cromosomas vacios
-        chromosomes.resize(6);
-        chromosomes[0] = Chromosome("FIFO");
-        chromosomes[1] = Chromosome("LTP");
-        chromosomes[2] = Chromosome("STP");
-        chromosomes[3] = Chromosome("RRFIFO");
-        chromosomes[4] = Chromosome("RRLTP");
-        chromosomes[5] = Chromosome("RRECA");
+    /*
+     Indica si algun cromosoma cambio desde la ultima evaluacion
+     bool: true si evaluarlo cuenta como una evaluacion
+     */
+    bool isDirty() const {
+        for (const auto& chromosome : chromosomes) {
+            if (chromosome.dirty) return true;
+        }
+        return false;
     }
     
     /*
      Inicializa el individuo con valores aleatorios para todos sus cromosomas
      
-     chromosomeSize: Numero de genes por cromosoma (total de operaciones)
      minValue: Valor minimo para los genes (tipicamente 1)
      maxValue: Valor maximo para los genes (tipicamente numMachines)
      rng: Generador de numeros aleatorios
      */
-    void initializeRandom(int chromosomeSize, int minValue, int maxValue, mt19937& rng) {
-        for (int i = 0; i < 6; i++) {
-            chromosomes[i].initializeRandom(chromosomeSize, minValue, maxValue, rng);
+    void initializeRandom(int minValue, int maxValue, RandomEngine& rng) {
+        for (int i = 0; i < NUM_POLICIES; i++) {
+            chromosomes[i].initializeRandom(minValue, maxValue, rng);
         }
     }
     
@@ -481,13 +921,13 @@ public:
         // Verificar que todos los cromosomas tengan el mismo tamaño
         int expectedSize = chromosomes[0].size();
         for (const auto& chromosome : chromosomes) {
-            if (chromosome.size() != expectedSize) {
+            if (chromosome.size() != expectedSize || chromosome.genes == nullptr) {
                 return false;
             }
             
             // Verificar que todos los genes sean positivos
-            for (int gene : chromosome.genes) {
-                if (gene <= 0) {
+            for (int i = 0; i < chromosome.size(); i++) {
+                if (chromosome.genes[i] == 0) {
                     return false;
                 }
             }
@@ -497,7 +937,71 @@ public:
     }
 };
 
-
+/*
+ Population
+ Conjunto de individuos cuyos genomas viven en una sola reserva de memoria (arena)
+ 
+ Cada individuo ocupa un bloque de 6 x chromosomeStride genes. Cada cromosoma
+ empieza alineado a 64 bytes, de modo que copiar, cruzar o calcular la huella
+ de un individuo recorre memoria contigua. La arena se reserva una vez al
+ construir la poblacion (para capacity individuos); resize solo cambia
+ cuantos de ellos forman parte de la poblacion, sin reservar memoria.
+ Mover la poblacion no invalida los genomas.
+ 
+ numIndividuals: Numero de individuos
+ numGenes: Genes por cromosoma (operaciones totales en el escenario)
+ capacity: Maximo numero de individuos (como minimo numIndividuals)
+ */
+class Population {
+public:
+    Population() : numGenes(0), chromosomeStride(0), active(0) {}
+    
+    Population(int numIndividuals, int numGenes, int capacity = 0) : numGenes(numGenes), active(numIndividuals) {
+        capacity = max(capacity, numIndividuals);
+        const size_t genesPerLine = 64 / sizeof(Gene);
+        chromosomeStride = (size_t(numGenes) + genesPerLine - 1) / genesPerLine * genesPerLine;
+        arena.assign(size_t(capacity) * NUM_POLICIES * chromosomeStride, Gene(0));
+        individuals.reserve(capacity);
+        for (int i = 0; i < capacity; i++) {
+            individuals.emplace_back(arena.data() + size_t(i) * NUM_POLICIES * chromosomeStride, numGenes, chromosomeStride);
+        }
+    }
+    
+    Population(const Population&) = delete;
+    Population& operator=(const Population&) = delete;
+    Population(Population&&) = default;
+    Population& operator=(Population&&) = default;
+    
+    size_t size() const { return active; }
+    size_t capacity() const { return individuals.size(); }
+    int getNumGenes() const { return numGenes; }
+    
+    /*
+     Cambia el numero de individuos de la poblacion
+     Los individuos que quedan fuera conservan sus genes, pero dejan de recorrerse.
+     */
+    void resize(size_t numIndividuals) {
+        if (numIndividuals > individuals.size()) {
+            throw runtime_error("ERROR: La poblacion no tiene capacidad para " + to_string(numIndividuals) + " individuos");
+        }
+        active = numIndividuals;
+    }
+    
+    Individual& operator[](size_t index) { return individuals[index]; }
+    const Individual& operator[](size_t index) const { return individuals[index]; }
+    
+    vector<Individual>::iterator begin() { return individuals.begin(); }
+    vector<Individual>::iterator end() { return individuals.begin() + active; }
+    vector<Individual>::const_iterator begin() const { return individuals.begin(); }
+    vector<Individual>::const_iterator end() const { return individuals.begin() + active; }
+    
+private:
+    int numGenes;
+    size_t chromosomeStride;
+    size_t active;
+    vector<Gene, AlignedAllocator<Gene, 64>> arena;
+    vector<Individual> individuals;
+};
 
 // FUNCIONES DE INICIALIZACIoN DE POBLACIoN
 
@@ -521,29 +1025,22 @@ int calculateTotalOperations(const ScenarioData& data) {
 /*
  Inicializa un individuo con valores aleatorios validos
  
- Crea un individuo poliploide donde cada cromosoma contiene genes
- con valores aleatorios en el rango [1, numMachines]. Este rango
- representa las prioridades de maquinas para cada operacion.
+ Llena cada cromosoma del individuo con genes aleatorios en el rango
+ [1, numMachines]. Este rango representa las prioridades de maquinas
+ para cada operacion.
  
+ individual: Individuo (de una Population) a inicializar
  data: Datos del escenario (para obtener dimensiones)
  rng: Generador de numeros aleatorios
- Individual: Individuo inicializado con valores aleatorios
  */
-Individual initializeIndividualRandom(const ScenarioData& data, mt19937& rng) {
-    Individual individual;
-    
-    // Calcular numero total de operaciones en el escenario
-    int totalOperations = calculateTotalOperations(data);
-    
+void initializeIndividualRandom(Individual& individual, const ScenarioData& data, RandomEngine& rng) {
     // Los genes pueden tomar valores de 1 a numMachines
     // Estos valores representan prioridades de maquinas
     int minValue = 1;
     int maxValue = data.numMachines;
     
     // Inicializar todos los cromosomas con valores aleatorios
-    individual.initializeRandom(totalOperations, minValue, maxValue, rng);
-    
-    return individual;
+    individual.initializeRandom(minValue, maxValue, rng);
 }
 
 /*
@@ -552,24 +1049,29 @@ Individual initializeIndividualRandom(const ScenarioData& data, mt19937& rng) {
  populationSize: Numero de individuos a crear
  data: Datos del escenario
  rng: Generador de numeros aleatorios
- vector<Individual>: Poblacion inicializada
+ capacity: Capacidad de la poblacion (ver generationCapacity)
+ Population: Poblacion inicializada
  */
-vector<Individual> initializePopulation(int populationSize, const ScenarioData& data, mt19937& rng) {
+Population initializePopulation(int populationSize, const ScenarioData& data, RandomEngine& rng, int capacity = 0) {
     printHeader("INICIALIZANDO POBLACION",50);
-    vector<Individual> population;
-    population.reserve(populationSize);
+    if (data.numMachines > numeric_limits<Gene>::max()) {
+        throw runtime_error("ERROR: El escenario tiene " + to_string(data.numMachines) +
+                            " maquinas y los genes admiten hasta " + to_string(numeric_limits<Gene>::max()) +
+                            " (compilar con -DPOLIPLOIDES_WIDE_GENES)");
+    }
+    
+    // Calcular numero total de operaciones en el escenario
+    Population population(populationSize, calculateTotalOperations(data), capacity);
     
     cout << "Inicializando poblacion de " << populationSize << " individuos..." << endl;
     
     for (int i = 0; i < populationSize; i++) {
-        Individual individual = initializeIndividualRandom(data, rng);
+        initializeIndividualRandom(population[i], data, rng);
         
         // Validar que el individuo sea correcto
-        if (!individual.isValid()) {
+        if (!population[i].isValid()) {
             throw runtime_error("ERROR: Individuo generado no es valido");
         }
-        
-        population.push_back(individual);
     }
     
     cout << "Poblacion inicializada exitosamente" << endl << endl;
@@ -577,163 +1079,155 @@ vector<Individual> initializePopulation(int populationSize, const ScenarioData&
     return population;
 }
 
-string trim(const string& str) {
-    size_t first = str.find_first_not_of(" \t\r\n");
-    if (first == string::npos) return "";
-    size_t last = str.find_last_not_of(" \t\r\n");
-    return str.substr(first, last - first + 1);
-}
-
-bool isCommentOrEmpty(const string& line) {
-    string trimmed = trim(line);
-    return trimmed.empty() || trimmed[0] == '#';
-}
-
-vector<double> parseLineToDoubles(const string& line) {
-    vector<double> values;
-    stringstream ss(line);
-    double value;
+/*
+ ScenarioReader
+ Tokenizador de un solo paso sobre el contenido completo del archivo de escenario
+ 
+ El archivo se lee una sola vez a memoria y se recorre con punteros, sin
+ construir strings intermedios por linea ni por token. Las dimensiones del
+ escenario (operaciones y maquinas) se infieren de las filas leidas.
+ 
+ cursor: Posicion actual de lectura dentro del buffer
+ end: Final del buffer
+ */
+class ScenarioReader {
+public:
+    ScenarioReader(const char* begin, const char* end) : cursor(begin), end(end) {}
     
-    while (ss >> value) {
-        values.push_back(value);
+    /*
+     Avanza a la siguiente linea del buffer
+     
+     line: Vista de la linea leida (sin el salto de linea ni espacios en los extremos)
+     bool: false cuando ya no quedan lineas
+     */
+    bool nextLine(string_view& line) {
+        if (cursor >= end) return false;
+        const char* lineEnd = static_cast<const char*>(memchr(cursor, '\n', end - cursor));
+        if (lineEnd == nullptr) lineEnd = end;
+        line = trimView(string_view(cursor, lineEnd - cursor));
+        cursor = (lineEnd < end) ? lineEnd + 1 : end;
+        return true;
     }
     
-    return values;
-}
-
-vector<int> parseJobOperations(const string& line) {
-    vector<int> operations;
-    
-    size_t start = line.find('{');
-    size_t end = line.find('}');
-    
-    if (start == string::npos || end == string::npos) {
-        return operations;
+    /*
+     Lee todos los valores reales de una linea y los agrega a values
+     
+     line: Linea a tokenizar (debe pertenecer al buffer del lector)
+     values: Vector reutilizable donde se escriben los valores (se limpia antes)
+     */
+    static void parseDoubles(string_view line, vector<double>& values) {
+        values.clear();
+        const char* p = line.data();
+        const char* lineEnd = p + line.size();
+        while (p < lineEnd) {
+            while (p < lineEnd && (*p == ' ' || *p == '\t' || *p == ',' || *p == ';')) p++;
+            if (p >= lineEnd) break;
+            char* next = nullptr;
+            double value = strtod(p, &next);
+            if (next == p || next > lineEnd) {
+                throw runtime_error("ERROR: Valor numerico invalido en la linea: " + string(line));
+            }
+            values.push_back(value);
+            p = next;
+        }
     }
     
-    string content = line.substr(start + 1, end - start - 1);
-    stringstream ss(content);
-    string token;
-    
-    while (getline(ss, token, ',')) {
-        token = trim(token);
-        size_t pos = token.find('O');
-        if (pos != string::npos && pos + 1 < token.length()) {
-            string numStr = token.substr(pos + 1);
-            int opNum = stoi(numStr);
-            operations.push_back(opNum - 1);
+    /*
+     Lee las operaciones de una linea de trabajo con formato J1={O2,O4,O5}
+     
+     line: Linea a tokenizar
+     operations: Vector reutilizable donde se escriben los indices (base 0) de las operaciones
+     */
+    static void parseJobOperations(string_view line, vector<int>& operations) {
+        operations.clear();
+        size_t start = line.find('{');
+        size_t close = line.find('}', start);
+        if (start == string_view::npos || close == string_view::npos) {
+            return;
+        }
+        const char* p = line.data() + start + 1;
+        const char* contentEnd = line.data() + close;
+        while (p < contentEnd) {
+            while (p < contentEnd && *p != 'O' && *p != 'o') p++;
+            if (p >= contentEnd) break;
+            p++;
+            int opNum = 0;
+            bool hasDigits = false;
+            while (p < contentEnd && *p >= '0' && *p <= '9') {
+                opNum = opNum * 10 + (*p - '0');
+                hasDigits = true;
+                p++;
+            }
+            if (hasDigits) {
+                operations.push_back(opNum - 1);
+            }
         }
     }
     
-    return operations;
-}
+private:
+    const char* cursor;
+    const char* end;
+    
+    static string_view trimView(string_view str) {
+        size_t first = str.find_first_not_of(" \t\r\n");
+        if (first == string_view::npos) return string_view();
+        size_t last = str.find_last_not_of(" \t\r\n");
+        return str.substr(first, last - first + 1);
+    }
+};
 
-ScenarioData loadScenario(const string& filename) {
-    ScenarioData data;
-    ifstream file(filename);
+/*
+ Lee el contenido completo de un archivo en un unico buffer
+ 
+ filename: Ruta del archivo
+ string: Contenido del archivo
+ */
+string readFileContents(const string& filename) {
+    ifstream file(filename, ios::binary);
     
     if (!file.is_open()) {
         throw runtime_error("ERROR: No se pudo abrir el archivo: " + filename);
     }
     
-    string line;
-    int section = 0;
-    int rowCount = 0;
+    file.seekg(0, ios::end);
+    streamoff size = file.tellg();
+    file.seekg(0, ios::beg);
     
-    data.processingTime.resize(data.numOperations, vector<double>(data.numMachines, 0.0));
-    data.energyCost.resize(data.numOperations, vector<double>(data.numMachines, 0.0));
+    string contents(static_cast<size_t>(size), '\0');
+    if (size > 0 && !file.read(&contents[0], size)) {
+        throw runtime_error("ERROR: No se pudo leer el archivo: " + filename);
+    }
+    return contents;
+}
 
-    printSubHeader("CARGANDO ESCENARIO DESDE: "+filename,50);
-    
-    while (getline(file, line)) {
-        if (isCommentOrEmpty(line)) {
-            string trimmed = trim(line);
-            
-            if (trimmed.find("tiempos") != string::npos || 
-                trimmed.find("Tiempos") != string::npos) {
-                section = 1;
-                rowCount = 0;
-                printSubHeader("TIEMPOS DE PROCESAMIENTO [Operacion][Maquina]",50);
-            }
-            else if (trimmed.find("energ") != string::npos || 
-                     trimmed.find("Energ") != string::npos) {
-                section = 2;
-                rowCount = 0;
-                printSubHeader("CONSUMO ENERGeTICO [Operacion][Maquina]",50);
-            }
-            else if (trimmed.find("Trabajo") != string::npos || 
-                     trimmed.find("trabajo") != string::npos) {
-                section = 3;
-                printSubHeader("TRABAJOS Y SUS OPERACIONES",50);
-            }
-            
-            continue;
-        }
-        
-        if (section == 1 && rowCount < data.numOperations) {
-            vector<double> times = parseLineToDoubles(line);
-            
-            if (times.size() != static_cast<size_t>(data.numMachines)) {
-                throw runtime_error("ERROR: Fila de tiempos con numero incorrecto de maquinas");
-            }
-            
-            for (int m = 0; m < data.numMachines; m++) {
-                data.processingTime[rowCount][m] = times[m];
-            }
-            
-            cout << "Op" << rowCount << ": ";
-            for (int m = 0; m < data.numMachines; m++) {
-                cout << data.processingTime[rowCount][m] << "\t";
-            }
-            cout << endl;
-            
-            rowCount++;
-        }
-        else if (section == 2 && rowCount < data.numOperations) {
-            vector<double> energy = parseLineToDoubles(line);
-            
-            if (energy.size() != static_cast<size_t>(data.numMachines)) {
-                throw runtime_error("ERROR: Fila de energia con numero incorrecto de maquinas");
-            }
-            
-            for (int m = 0; m < data.numMachines; m++) {
-                data.energyCost[rowCount][m] = energy[m];
-            }
-            
-            cout << "Op" << rowCount << ": ";
-            for (int m = 0; m < data.numMachines; m++) {
-                cout << data.energyCost[rowCount][m] << "\t";
-            }
-            cout << endl;
-            
-            rowCount++;
-        }
-        else if (section == 3) {
-            vector<int> ops = parseJobOperations(line);
-            
-            if (!ops.empty()) {
-                Job job(data.numJobs);
-                job.operations = ops;
-                data.jobs.push_back(job);
-                
-                cout << "Job" << data.numJobs << ": ";
-                for (size_t i = 0; i < ops.size(); i++) {
-                    cout << "O" << (ops[i] + 1);
-                    if (i < ops.size() - 1) cout << " -> ";
-                }
-                cout << " (" << ops.size() << " operaciones)" << endl;
-                
-                data.numJobs++;
-            }
-        }
+/*
+ Copia una fila leida en la matriz indicada, fijando el numero de maquinas
+ con la primera fila del escenario
+ */
+void appendMatrixRow(CostMatrix& matrix, const vector<double>& row, ScenarioData& data, const string& errorMessage) {
+    if (data.numMachines == 0) {
+        data.numMachines = row.size();
     }
-    
-    file.close();
-    vector<string> policyNames = {"FIFO", "LTP", "STP", "RRFIFO", "RRLTP", "RRECA"};
+    if (row.size() != static_cast<size_t>(data.numMachines)) {
+        throw runtime_error(errorMessage);
+    }
+    matrix.appendRow(row.data(), row.size());
+}
 
-    vector<pair<Job, double>> jobsWithTimes;
-    vector<pair<Job, double>> jobsWithEnergy;
-    for (auto job : data.jobs){
+/*
+ Construye las tablas de decodificacion gen -> (trabajo, operacion) de cada politica
+ 
+ El orden de las operaciones en el cromosoma depende de la politica:
+ FIFO respeta el orden del archivo, LTP/STP ordenan los trabajos por tiempo
+ promedio y las variantes RR intercalan los trabajos en round robin.
+ 
+ data: Escenario con matrices y trabajos ya cargados (se llena decodeTables)
+ verbose: Imprime el mapeo gen -> operacion de cada politica
+ */
+void buildDecodeTables(ScenarioData& data, bool verbose = false) {
+    vector<pair<int, double>> jobsWithTimes;
+    vector<pair<int, double>> jobsWithEnergy;
+    for (const auto& job : data.jobs){
         double totalTime = 0.0;
         double totalEnergy = 0.0;
         for (auto op : job.operations){
@@ -746,18 +1240,22 @@ ScenarioData loadScenario(const string& filename) {
             totalTime += (tempTime/data.numMachines);
             totalEnergy += (tempEnergy/data.numMachines);
         }
-        jobsWithTimes.push_back({job, totalTime});
-        jobsWithEnergy.push_back({job, totalEnergy});
+        jobsWithTimes.push_back({job.id, totalTime});
+        jobsWithEnergy.push_back({job.id, totalEnergy});
     } 
-    for (const string& policy : policyNames) {
-        data.chromosomeMapping[policy] = {};
-        cout << "\nMapping para politica: " << policy << "..." << endl;
-        vector<queue<pair<Job,Operation>>> roundRobinVector(data.numJobs);
+    data.decodeTables.assign(policyNames.size(), {});
+    for (size_t p = 0; p < policyNames.size(); p++) {
+        const string& policy = policyNames[p];
+        vector<GeneDecode>& table = data.decodeTables[p];
+        table.reserve(data.totalOperations);
+        if (verbose) {
+            cout << "\nMapping para politica: " << policy << "..." << endl;
+        }
+        vector<queue<GeneDecode>> roundRobinVector(data.numJobs);
         if (policy == "FIFO"){
-            for (auto job : data.jobs){
+            for (const auto& job : data.jobs){
                 for (auto op : job.operations){
-                    Operation operation(op);
-                    data.chromosomeMapping[policy].push_back({job, operation});
+                    table.push_back({job.id, op});
                 }
             } 
         }
@@ -767,9 +1265,8 @@ ScenarioData loadScenario(const string& filename) {
                     return a.second > b.second;
                 });
             for (const auto& pair : jobsWithTimes) {
-                auto job = pair.first;
-                for (auto op : pair.first.operations){
-                    data.chromosomeMapping[policy].push_back({job, op});
+                for (auto op : data.jobs[pair.first].operations){
+                    table.push_back({pair.first, op});
                 }
             }
         }
@@ -779,18 +1276,16 @@ ScenarioData loadScenario(const string& filename) {
                     return a.second < b.second;
                 });
             for (const auto& pair : jobsWithTimes) {
-                auto job = pair.first;
-                for (auto op : pair.first.operations){
-                    data.chromosomeMapping[policy].push_back({job, op});
+                for (auto op : data.jobs[pair.first].operations){
+                    table.push_back({pair.first, op});
                 }
             }
         }
         else if(policy == "RRFIFO" || policy == "RRECA" || policy == "RRLTP"){
             if (policy == "RRFIFO"){
                 for (int i=0; i < data.numJobs; i++){
-                    Job job = data.jobs[i];
                     for (auto op : data.jobs[i].operations){
-                        roundRobinVector[i].push({job,op});
+                        roundRobinVector[i].push({i,op});
                     }
                 } 
             }
@@ -800,9 +1295,9 @@ ScenarioData loadScenario(const string& filename) {
                         return a.second > b.second;
                     });
                 for (int i=0; i < data.numJobs; i++){
-                    Job job = jobsWithTimes[i].first;
-                    for (auto op : job.operations){
-                        roundRobinVector[i].push({job,op});
+                    int jobId = jobsWithTimes[i].first;
+                    for (auto op : data.jobs[jobId].operations){
+                        roundRobinVector[i].push({jobId,op});
                     }
                 } 
             }
@@ -812,9 +1307,9 @@ ScenarioData loadScenario(const string& filename) {
                         return a.second < b.second;
                     });
                 for (int i=0; i < data.numJobs; i++){
-                    Job job = jobsWithTimes[i].first;
-                    for (auto op : job.operations){
-                        roundRobinVector[i].push({job,op});
+                    int jobId = jobsWithTimes[i].first;
+                    for (auto op : data.jobs[jobId].operations){
+                        roundRobinVector[i].push({jobId,op});
                     }
                 } 
             }
@@ -823,7 +1318,7 @@ ScenarioData loadScenario(const string& filename) {
                 for (int i = 0; i < numJobs; i++) {
                     
                     if (!roundRobinVector[i].empty()) {
-                        data.chromosomeMapping[policy].push_back(roundRobinVector[i].front());
+                        table.push_back(roundRobinVector[i].front());
                         roundRobinVector[i].pop();
                     }
                     else {
@@ -833,17 +1328,472 @@ ScenarioData loadScenario(const string& filename) {
                 }
             }
         }
-        for (size_t i = 0; i < data.chromosomeMapping[policy].size(); i++){
-            cout << "Cromosoma Index: " << i << " -> Operacion: [J"<<data.chromosomeMapping[policy][i].first.id + 1 <<" O" << data.chromosomeMapping[policy][i].second.id +1 <<"]"<< endl;
+        for (size_t i = 0; verbose && i < table.size(); i++){
+            cout << "Cromosoma Index: " << i << " -> Operacion: [J"<<table[i].jobId + 1 <<" O" << table[i].opId +1 <<"]"<< endl;
         }
     }
+}
+
+/*
+ Carga un escenario en formato texto (Escenario1.txt)
+ 
+ Sin verbose solo se imprime un resumen al terminar: volcar cada fila y
+ cada mapeo domina el tiempo de carga en escenarios grandes.
+ 
+ filename: Ruta del escenario
+ verbose: Imprime las matrices, los trabajos y los mapeos mientras se leen
+ */
+ScenarioData loadScenarioText(const string& filename, bool verbose = false) {
+    ScenarioData data;
+    string contents = readFileContents(filename);
+    ScenarioReader reader(contents.data(), contents.data() + contents.size());
+    
+    string_view line;
+    int section = 0;
+    vector<double> rowValues;
+    vector<int> ops;
+
+    printSubHeader("CARGANDO ESCENARIO DESDE: "+filename,50);
+    
+    while (reader.nextLine(line)) {
+        if (line.empty() || line[0] == '#') {
+            if (line.find("tiempos") != string_view::npos || 
+                line.find("Tiempos") != string_view::npos) {
+                section = 1;
+                if (verbose) printSubHeader("TIEMPOS DE PROCESAMIENTO [Operacion][Maquina]",50);
+            }
+            else if (line.find("energ") != string_view::npos || 
+                     line.find("Energ") != string_view::npos) {
+                section = 2;
+                if (verbose) printSubHeader("CONSUMO ENERGeTICO [Operacion][Maquina]",50);
+            }
+            else if (line.find("Trabajo") != string_view::npos || 
+                     line.find("trabajo") != string_view::npos) {
+                section = 3;
+                if (verbose) printSubHeader("TRABAJOS Y SUS OPERACIONES",50);
+            }
+            
+            continue;
+        }
         
+        if (section == 1) {
+            ScenarioReader::parseDoubles(line, rowValues);
+            appendMatrixRow(data.processingTime, rowValues, data,
+                            "ERROR: Fila de tiempos con numero incorrecto de maquinas");
+            if (!verbose) continue;
+            
+            int rowCount = data.processingTime.numRows() - 1;
+            cout << "Op" << rowCount << ": ";
+            for (int m = 0; m < data.numMachines; m++) {
+                cout << data.processingTime[rowCount][m] << "\t";
+            }
+            cout << endl;
+        }
+        else if (section == 2) {
+            ScenarioReader::parseDoubles(line, rowValues);
+            appendMatrixRow(data.energyCost, rowValues, data,
+                            "ERROR: Fila de energia con numero incorrecto de maquinas");
+            if (!verbose) continue;
+            
+            int rowCount = data.energyCost.numRows() - 1;
+            cout << "Op" << rowCount << ": ";
+            for (int m = 0; m < data.numMachines; m++) {
+                cout << data.energyCost[rowCount][m] << "\t";
+            }
+            cout << endl;
+        }
+        else if (section == 3) {
+            ScenarioReader::parseJobOperations(line, ops);
+            
+            if (!ops.empty()) {
+                Job job(data.numJobs);
+                job.operations = ops;
+                data.jobs.push_back(job);
+                
+                if (verbose) {
+                    cout << "Job" << data.numJobs << ": ";
+                    for (size_t i = 0; i < ops.size(); i++) {
+                        cout << "O" << (ops[i] + 1);
+                        if (i < ops.size() - 1) cout << " -> ";
+                    }
+                    cout << " (" << ops.size() << " operaciones)" << endl;
+                }
+                
+                data.numJobs++;
+            }
+        }
+    }
+    
+    data.numOperations = data.processingTime.numRows();
+    if (data.numOperations == 0 || data.numMachines == 0) {
+        throw runtime_error("ERROR: El escenario no contiene tiempos de procesamiento");
+    }
+    if (data.energyCost.numRows() != data.numOperations) {
+        throw runtime_error("ERROR: Numero de filas de energia distinto al numero de operaciones");
+    }
+    for (const auto& job : data.jobs) {
+        for (int op : job.operations) {
+            if (op < 0 || op >= data.numOperations) {
+                throw runtime_error("ERROR: El trabajo J" + to_string(job.id + 1) +
+                                    " referencia una operacion inexistente: O" + to_string(op + 1));
+            }
+        }
+    }
+    data.totalOperations = calculateTotalOperations(data);
+    
+    buildDecodeTables(data, verbose);
+    
+    cout << "Operaciones: " << data.numOperations << ", Maquinas: " << data.numMachines
+         << ", Trabajos: " << data.numJobs << endl;
+    cout << "\nEscenario cargado exitosamente" << endl;
+    printDivider(50);
+    
+    return data;
+}
+
+// FORMATO BINARIO COMPILADO DE ESCENARIOS
+
+/*
+ ScenarioImageHeader
+ Cabecera de la imagen binaria de un escenario compilado
+ 
+ La imagen contiene, despues de la cabecera y alineadas a 8 bytes:
+ - timeOffset: Matriz de tiempos [numOperations x numMachines] (double, fila mayor)
+ - energyOffset: Matriz de energia [numOperations x numMachines] (double, fila mayor)
+ - jobStartOffset: Inicio de cada trabajo en jobOpsOffset, numJobs + 1 entradas (int32, CSR)
+ - jobOpsOffset: Operaciones de todos los trabajos concatenadas (int32, CSR)
+ - mappingOffset: Tablas de decodificacion, numPolicies x totalOperations GeneDecode (int32, int32)
+ 
+ magic: Identificador del formato ("POLISCN")
+ version: Version del formato, debe coincidir con SCENARIO_IMAGE_VERSION
+ byteOrder: Marca para detectar imagenes generadas con otro orden de bytes
+ fileSize: Tamaño total esperado de la imagen
+ */
+struct ScenarioImageHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t numOperations;
+    uint32_t numMachines;
+    uint32_t numJobs;
+    uint32_t totalOperations;
+    uint32_t numPolicies;
+    uint32_t reserved;
+    uint64_t timeOffset;
+    uint64_t energyOffset;
+    uint64_t jobStartOffset;
+    uint64_t jobOpsOffset;
+    uint64_t mappingOffset;
+    uint64_t fileSize;
+};
+
+const char SCENARIO_IMAGE_MAGIC[8] = {'P', 'O', 'L', 'I', 'S', 'C', 'N', '\0'};
+const uint32_t SCENARIO_IMAGE_VERSION = 1;
+const uint32_t SCENARIO_IMAGE_BYTE_ORDER = 0x01020304;
+
+static_assert(sizeof(GeneDecode) == 2 * sizeof(int32_t), "GeneDecode debe coincidir con el formato de la imagen");
+
+/*
+ MappedFile
+ Proyeccion en memoria de solo lectura de un archivo completo
+ 
+ La proyeccion se libera automaticamente al destruir el objeto.
+ 
+ data: Puntero al inicio del contenido proyectado
+ size: Tamaño del archivo en bytes
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const string& filename) : data(nullptr), size(0) {
+    #if defined(_WIN32)
+        fileHandle = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                 OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE) {
+            throw runtime_error("ERROR: No se pudo abrir el archivo: " + filename);
+        }
+        LARGE_INTEGER fileSize;
+        GetFileSizeEx(fileHandle, &fileSize);
+        size = static_cast<size_t>(fileSize.QuadPart);
+        mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mappingHandle == nullptr) {
+            CloseHandle(fileHandle);
+            throw runtime_error("ERROR: No se pudo proyectar en memoria el archivo: " + filename);
+        }
+        data = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+        if (data == nullptr) {
+            CloseHandle(mappingHandle);
+            CloseHandle(fileHandle);
+            throw runtime_error("ERROR: No se pudo proyectar en memoria el archivo: " + filename);
+        }
+    #else
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw runtime_error("ERROR: No se pudo abrir el archivo: " + filename);
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size == 0) {
+            close(fd);
+            throw runtime_error("ERROR: Archivo vacio o ilegible: " + filename);
+        }
+        size = static_cast<size_t>(info.st_size);
+        void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (mapped == MAP_FAILED) {
+            throw runtime_error("ERROR: No se pudo proyectar en memoria el archivo: " + filename);
+        }
+        data = static_cast<const char*>(mapped);
+    #endif
+    }
+    
+    ~MappedFile() {
+    #if defined(_WIN32)
+        UnmapViewOfFile(data);
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+    #else
+        munmap(const_cast<char*>(data), size);
+    #endif
+    }
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    
+    const char* data;
+    size_t size;
+    
+private:
+    #if defined(_WIN32)
+    HANDLE fileHandle;
+    HANDLE mappingHandle;
+    #endif
+};
+
+/*
+ Indica si un archivo es una imagen binaria de escenario (revisa el identificador)
+ */
+bool isScenarioImage(const string& filename) {
+    ifstream file(filename, ios::binary);
+    char magic[sizeof(SCENARIO_IMAGE_MAGIC)] = {};
+    file.read(magic, sizeof(magic));
+    return file.gcount() == sizeof(magic) && memcmp(magic, SCENARIO_IMAGE_MAGIC, sizeof(magic)) == 0;
+}
+
+/*
+ Compila un escenario ya cargado a una imagen binaria versionada
+ 
+ Guarda las matrices planas, los trabajos en formato CSR y el mapeo
+ precalculado de cada politica, de modo que la carga posterior no tenga
+ que interpretar texto ni reconstruir las tablas de decodificacion.
+ 
+ data: Escenario cargado (por ejemplo con loadScenarioText)
+ filename: Ruta de la imagen a generar
+ */
+void compileScenario(const ScenarioData& data, const string& filename) {
+    auto align8 = [](uint64_t offset) { return (offset + 7) & ~uint64_t(7); };
+    
+    uint64_t totalOperations = calculateTotalOperations(data);
+    uint64_t matrixBytes = uint64_t(data.numOperations) * data.numMachines * sizeof(double);
+    
+    ScenarioImageHeader header = {};
+    memcpy(header.magic, SCENARIO_IMAGE_MAGIC, sizeof(header.magic));
+    header.version = SCENARIO_IMAGE_VERSION;
+    header.byteOrder = SCENARIO_IMAGE_BYTE_ORDER;
+    header.numOperations = data.numOperations;
+    header.numMachines = data.numMachines;
+    header.numJobs = data.numJobs;
+    header.totalOperations = totalOperations;
+    header.numPolicies = policyNames.size();
+    header.timeOffset = align8(sizeof(ScenarioImageHeader));
+    header.energyOffset = align8(header.timeOffset + matrixBytes);
+    header.jobStartOffset = align8(header.energyOffset + matrixBytes);
+    header.jobOpsOffset = align8(header.jobStartOffset + (uint64_t(data.numJobs) + 1) * sizeof(int32_t));
+    header.mappingOffset = align8(header.jobOpsOffset + totalOperations * sizeof(int32_t));
+    header.fileSize = header.mappingOffset + header.numPolicies * totalOperations * 2 * sizeof(int32_t);
+    
+    vector<char> image(header.fileSize, 0);
+    memcpy(image.data(), &header, sizeof(header));
+    
+    double* times = reinterpret_cast<double*>(image.data() + header.timeOffset);
+    double* energy = reinterpret_cast<double*>(image.data() + header.energyOffset);
+    for (int op = 0; op < data.numOperations; op++) {
+        memcpy(times + size_t(op) * data.numMachines, data.processingTime[op], data.numMachines * sizeof(double));
+        memcpy(energy + size_t(op) * data.numMachines, data.energyCost[op], data.numMachines * sizeof(double));
+    }
+    
+    int32_t* jobStart = reinterpret_cast<int32_t*>(image.data() + header.jobStartOffset);
+    int32_t* jobOps = reinterpret_cast<int32_t*>(image.data() + header.jobOpsOffset);
+    int32_t position = 0;
+    for (int j = 0; j < data.numJobs; j++) {
+        jobStart[j] = position;
+        for (int op : data.jobs[j].operations) {
+            jobOps[position++] = op;
+        }
+    }
+    jobStart[data.numJobs] = position;
+    
+    GeneDecode* mapping = reinterpret_cast<GeneDecode*>(image.data() + header.mappingOffset);
+    for (size_t p = 0; p < policyNames.size(); p++) {
+        const vector<GeneDecode>& table = data.decodeTables.at(p);
+        if (table.size() != totalOperations) {
+            throw runtime_error("ERROR: Mapeo incompleto para la politica " + policyNames[p]);
+        }
+        memcpy(mapping, table.data(), table.size() * sizeof(GeneDecode));
+        mapping += table.size();
+    }
+    
+    ofstream file(filename, ios::binary | ios::trunc);
+    if (!file.is_open()) {
+        throw runtime_error("ERROR: No se pudo crear el archivo: " + filename);
+    }
+    file.write(image.data(), image.size());
+    if (!file) {
+        throw runtime_error("ERROR: No se pudo escribir el archivo: " + filename);
+    }
+}
+
+/*
+ Carga rapida de un escenario desde una imagen binaria compilada con compileScenario
+ 
+ El archivo se proyecta en memoria y sus bloques se copian con memcpy a
+ ScenarioData (las matrices necesitan filas alineadas y el escenario vive
+ mas que la proyeccion), sin interpretar texto ni recalcular los mapeos de
+ politicas. No es una carga sin copias: el costo es una copia lineal del
+ archivo.
+ 
+ Nada de la cabecera se da por bueno: los tamaños se calculan en 64 bits
+ revisando desbordes, y las tablas de decodificacion deben recorrer las
+ operaciones de cada trabajo exactamente una vez y en su orden.
+ 
+ filename: Ruta de la imagen binaria
+ ScenarioData: Escenario listo para evaluar
+ */
+ScenarioData loadScenarioBinary(const string& filename) {
+    MappedFile file(filename);
+    printSubHeader("CARGANDO ESCENARIO BINARIO DESDE: "+filename,50);
+    
+    if (file.size < sizeof(ScenarioImageHeader)) {
+        throw runtime_error("ERROR: Imagen de escenario truncada: " + filename);
+    }
+    ScenarioImageHeader header;
+    memcpy(&header, file.data, sizeof(header));
+    
+    if (memcmp(header.magic, SCENARIO_IMAGE_MAGIC, sizeof(header.magic)) != 0) {
+        throw runtime_error("ERROR: El archivo no es una imagen de escenario: " + filename);
+    }
+    if (header.byteOrder != SCENARIO_IMAGE_BYTE_ORDER) {
+        throw runtime_error("ERROR: Imagen de escenario con orden de bytes incompatible: " + filename);
+    }
+    if (header.version != SCENARIO_IMAGE_VERSION) {
+        throw runtime_error("ERROR: Version de imagen de escenario no soportada (" +
+                            to_string(header.version) + "), recompile el escenario");
+    }
+    if (header.numPolicies != policyNames.size()) {
+        throw runtime_error("ERROR: La imagen de escenario no contiene las " +
+                            to_string(policyNames.size()) + " politicas esperadas");
+    }
+    
+    const uint32_t maxCount = uint32_t(numeric_limits<int32_t>::max());
+    if (header.numOperations == 0 || header.numMachines == 0 || header.numOperations > maxCount ||
+        header.numMachines > maxCount || header.numJobs >= maxCount || header.totalOperations > maxCount) {
+        throw runtime_error("ERROR: Imagen de escenario corrupta: " + filename);
+    }
+    
+    // Producto de tamaños de la cabecera; un desborde se marca con el maximo (nunca cabe)
+    auto product = [](uint64_t a, uint64_t b) {
+        return (a != 0 && b > numeric_limits<uint64_t>::max() / a) ? numeric_limits<uint64_t>::max() : a * b;
+    };
+    uint64_t matrixBytes = product(product(header.numOperations, header.numMachines), sizeof(double));
+    auto fits = [&](uint64_t offset, uint64_t bytes) {
+        return offset % 8 == 0 && offset <= file.size && bytes <= file.size - offset;
+    };
+    if (header.fileSize != file.size ||
+        !fits(header.timeOffset, matrixBytes) ||
+        !fits(header.energyOffset, matrixBytes) ||
+        !fits(header.jobStartOffset, (uint64_t(header.numJobs) + 1) * sizeof(int32_t)) ||
+        !fits(header.jobOpsOffset, uint64_t(header.totalOperations) * sizeof(int32_t)) ||
+        !fits(header.mappingOffset, product(uint64_t(header.numPolicies) * header.totalOperations, sizeof(GeneDecode)))) {
+        throw runtime_error("ERROR: Imagen de escenario corrupta: " + filename);
+    }
+    
+    ScenarioData data;
+    data.numOperations = header.numOperations;
+    data.numMachines = header.numMachines;
+    data.numJobs = header.numJobs;
+    data.totalOperations = header.totalOperations;
+    
+    const double* times = reinterpret_cast<const double*>(file.data + header.timeOffset);
+    const double* energy = reinterpret_cast<const double*>(file.data + header.energyOffset);
+    data.processingTime.resize(data.numOperations, data.numMachines);
+    data.energyCost.resize(data.numOperations, data.numMachines);
+    for (int op = 0; op < data.numOperations; op++) {
+        const double* timeRow = times + size_t(op) * data.numMachines;
+        const double* energyRow = energy + size_t(op) * data.numMachines;
+        memcpy(data.processingTime[op], timeRow, data.numMachines * sizeof(double));
+        memcpy(data.energyCost[op], energyRow, data.numMachines * sizeof(double));
+    }
+    
+    const int32_t* jobStart = reinterpret_cast<const int32_t*>(file.data + header.jobStartOffset);
+    const int32_t* jobOps = reinterpret_cast<const int32_t*>(file.data + header.jobOpsOffset);
+    if (jobStart[0] != 0 || jobStart[data.numJobs] != int32_t(header.totalOperations)) {
+        throw runtime_error("ERROR: Imagen de escenario corrupta: " + filename);
+    }
+    data.jobs.reserve(data.numJobs);
+    for (int j = 0; j < data.numJobs; j++) {
+        if (jobStart[j + 1] < jobStart[j]) {
+            throw runtime_error("ERROR: Imagen de escenario corrupta: " + filename);
+        }
+        Job job(j);
+        job.operations.assign(jobOps + jobStart[j], jobOps + jobStart[j + 1]);
+        for (int op : job.operations) {
+            if (op < 0 || op >= data.numOperations) {
+                throw runtime_error("ERROR: Imagen de escenario corrupta: " + filename);
+            }
+        }
+        data.jobs.push_back(move(job));
+    }
+    
+    // Cada tabla debe nombrar las operaciones de cada trabajo una sola vez y en el orden del trabajo
+    const GeneDecode* mapping = reinterpret_cast<const GeneDecode*>(file.data + header.mappingOffset);
+    data.decodeTables.resize(policyNames.size());
+    vector<size_t> nextOperation(data.numJobs);
+    for (auto& table : data.decodeTables) {
+        table.assign(mapping, mapping + header.totalOperations);
+        mapping += header.totalOperations;
+        fill(nextOperation.begin(), nextOperation.end(), 0);
+        for (const GeneDecode& gene : table) {
+            if (gene.jobId < 0 || gene.jobId >= data.numJobs) {
+                throw runtime_error("ERROR: Imagen de escenario corrupta: " + filename);
+            }
+            const vector<int>& operations = data.jobs[gene.jobId].operations;
+            size_t& next = nextOperation[gene.jobId];
+            if (next >= operations.size() || operations[next] != gene.opId) {
+                throw runtime_error("ERROR: Imagen de escenario con mapeo inconsistente con sus trabajos: " + filename);
+            }
+            next++;
+        }
+    }
+    
+    cout << "Operaciones: " << data.numOperations << ", Maquinas: " << data.numMachines
+         << ", Trabajos: " << data.numJobs << endl;
     cout << "\nEscenario cargado exitosamente" << endl;
     printDivider(50);
     
     return data;
 }
 
+/*
+ Carga un escenario, ya sea en formato texto (Escenario1.txt) o como
+ imagen binaria compilada con compileScenario
+ 
+ verbose: Imprime el contenido de los escenarios de texto mientras se leen
+ */
+ScenarioData loadScenario(const string& filename, bool verbose = false) {
+    if (isScenarioImage(filename)) {
+        return loadScenarioBinary(filename);
+    }
+    return loadScenarioText(filename, verbose);
+}
+
 // MoDULO DE EVALUACIoN DE INDIVIDUOS POLIPLOIDES
 /*
  Calcula el tiempo de inicio valido para una operacion
@@ -926,6 +1876,60 @@ OperationSchedule scheduleOperation(
     return schedule;
 }
 
+/*
+ Version reducida de scheduleOperation para las evaluaciones que solo
+ necesitan el fitness: actualiza maquina y trabajo sin registrar el scheduling
+ */
+inline void simulateOperation(
+    int opId,
+    int jobId,
+    int machineId,
+    MachineState* machines,
+    JobState* jobStates,
+    const ScenarioData& data
+) {
+    double startTime = calculateStartTime(
+        machines[machineId].currentTime,
+        jobStates[jobId].lastOperationEndTime
+    );
+    double endTime = startTime + data.processingTime[opId][machineId];
+    
+    machines[machineId].currentTime = endTime;
+    machines[machineId].totalEnergy += data.energyCost[opId][machineId];
+    machines[machineId].isActive = true;
+    
+    jobStates[jobId].lastOperationEndTime = endTime;
+    jobStates[jobId].nextOperationIndex++;
+}
+
+/*
+ Calcula el fitness de un cromosoma a partir del estado final de las maquinas
+ 
+ f1 (makespan) es el mayor tiempo de finalizacion entre las maquinas activas
+ y f2 la suma de su energia consumida.
+ 
+ chromosome: Cromosoma evaluado (se actualizan f1 y f2)
+ machines: Estado final de las maquinas
+ numMachines: Numero de maquinas
+ */
+void assignFitness(Chromosome& chromosome, const MachineState* machines, size_t numMachines) {
+    double makespan = 0.0;
+    double totalEnergy = 0.0;
+    for (size_t m = 0; m < numMachines; m++) {
+        const MachineState& machine = machines[m];
+        if (machine.isActive) {
+            if (machine.currentTime > makespan) {
+                makespan = machine.currentTime;
+            }
+            totalEnergy += machine.totalEnergy;
+        }
+    }
+    
+    chromosome.f1 = makespan;
+    chromosome.f2 = totalEnergy;
+    chromosome.markClean();
+}
+
 /*
  Imprime el scheduling completo de forma legible
  
@@ -957,12 +1961,11 @@ void printSchedule(const vector<OperationSchedule>& schedule, const ScenarioData
 vector<OperationSchedule> evaluateChromosome(Chromosome& chromosome, const ScenarioData& data, bool printScheduleFlag = false) {
     vector<OperationSchedule> schedule;
     // Validar tamaño del cromosoma
-    int totalOperations = calculateTotalOperations(data);
-    if (chromosome.size() != totalOperations) {
+    if (chromosome.size() != data.totalOperations) {
         cerr << "ERROR: Tamaño de cromosoma no coincide con numero de operaciones" << endl;
         return schedule;
     }
-    string policy = chromosome.policyName;
+    const vector<GeneDecode>& decode = data.decodeTables[chromosome.policy];
     
     // Inicializar estados de todas las maquinas
     vector<MachineState> machines(data.numMachines);
@@ -970,9 +1973,9 @@ vector<OperationSchedule> evaluateChromosome(Chromosome& chromosome, const Scena
     // Inicializar estados de todos los trabajos
     vector<JobState> jobStates(data.numJobs);
 
-    for (int i = 0; i< chromosome.genes.size(); i++){
-        int operationId = data.chromosomeMapping.at(policy)[i].second.id;
-        int jobId = data.chromosomeMapping.at(policy)[i].first.id;
+    for (int i = 0; i< chromosome.size(); i++){
+        int operationId = decode[i].opId;
+        int jobId = decode[i].jobId;
         int machineId = chromosome.genes[i] - 1;
         // Programar la operacion en la maquina seleccionada
         OperationSchedule opSchedule = scheduleOperation(
@@ -987,36 +1990,97 @@ vector<OperationSchedule> evaluateChromosome(Chromosome& chromosome, const Scena
         // Guardar la operacion programada
         schedule.push_back(opSchedule);
     }
-    double makespan = 0.0;
-    double totalEnergy = 0.0;
-    for (const auto& machine : machines) {
-        if (machine.isActive) {
-            if (machine.currentTime > makespan) {
-                makespan = machine.currentTime;
-            }
-            totalEnergy += machine.totalEnergy;
-        }
-    }
-    
-    chromosome.f1 = makespan;
-    chromosome.f2 = totalEnergy;    
+    assignFitness(chromosome, machines.data(), machines.size());
     return schedule;
 }
 
 /*
- Evalua todas las politicas de un individuo
+ Evalua unicamente el fitness (makespan y energia) de un cromosoma
  
- Ejecuta la evaluacion para los 6 cromosomas del individuo y
- muestra un resumen comparativo de todas las politicas
+ Realiza la misma simulacion que evaluateChromosome, pero sin construir el
+ scheduling: el estado de maquinas y trabajos se toma de scratch, que debe
+ estar preparado para el escenario.
  
- individual: Individuo a evaluar completamente
+ Con checkpointInterval > 0 se guardan checkpoints del estado cada
+ checkpointInterval genes y, si el cromosoma ya tenia checkpoints validos
+ antes de su primer gen modificado (dirtyFrom), la simulacion se reanuda
+ desde el ultimo de ellos en lugar de empezar en el tiempo cero. Con
+ checkpointInterval = 0 la evaluacion no reserva memoria.
+ 
+ chromosome: Cromosoma a evaluar (se actualizan f1, f2 y sus checkpoints)
  data: Datos del escenario
+ scratch: Estado de simulacion reutilizable
+ checkpointInterval: Genes entre checkpoints (0 para no usar checkpoints)
  */
-void evaluateAllPolicies(Individual& individual, const ScenarioData& data, string individuo, bool showTable = false, bool showSchedule = false) {
-    vector<vector<OperationSchedule>> allSchedules;
-    for (int i = 0; i < individual.getNumChromosomes(); i++) {
-        vector<OperationSchedule> schedule = evaluateChromosome(individual.chromosomes[i], data, showSchedule);
-        string policy = individual.chromosomes[i].policyName;
+void evaluateChromosomeFitness(Chromosome& chromosome, const ScenarioData& data, EvaluationScratch& scratch, int checkpointInterval = 0) {
+    if (chromosome.size() != data.totalOperations) {
+        cerr << "ERROR: Tamaño de cromosoma no coincide con numero de operaciones" << endl;
+        return;
+    }
+    const vector<GeneDecode>& decode = data.decodeTables[chromosome.policy];
+    
+    MachineState* machines = scratch.machines.data();
+    JobState* jobStates = scratch.jobStates.data();
+    const Gene* genes = chromosome.genes;
+    const int numGenes = data.totalOperations;
+    
+    if (checkpointInterval <= 0 || checkpointInterval >= numGenes) {
+        scratch.reset();
+        for (int i = 0; i < numGenes; i++) {
+            simulateOperation(decode[i].opId, decode[i].jobId, genes[i] - 1, machines, jobStates, data);
+        }
+        assignFitness(chromosome, machines, scratch.machines.size());
+        return;
+    }
+    
+    // Reanudar desde el ultimo checkpoint anterior al primer gen modificado
+    auto updated = make_shared<SimulationCheckpoints>();
+    updated->interval = checkpointInterval;
+    size_t reusable = 0;
+    if (chromosome.checkpoints && chromosome.checkpoints->interval == checkpointInterval) {
+        reusable = chromosome.checkpoints->validBefore(chromosome.dirty ? chromosome.dirtyFrom : numGenes);
+    }
+    if (reusable > 0) {
+        const auto& snapshots = chromosome.checkpoints->snapshots;
+        updated->snapshots.assign(snapshots.begin(), snapshots.begin() + reusable);
+        copy(snapshots[reusable - 1]->machines.begin(), snapshots[reusable - 1]->machines.end(), machines);
+        copy(snapshots[reusable - 1]->jobStates.begin(), snapshots[reusable - 1]->jobStates.end(), jobStates);
+    } else {
+        scratch.reset();
+    }
+    
+    const int start = reusable * checkpointInterval;
+    for (int blockStart = start; blockStart < numGenes; blockStart += checkpointInterval) {
+        if (blockStart > start) {
+            auto snapshot = make_shared<SimulationSnapshot>();
+            snapshot->machines = scratch.machines;
+            snapshot->jobStates = scratch.jobStates;
+            updated->snapshots.push_back(move(snapshot));
+        }
+        int blockEnd = min(numGenes, blockStart + checkpointInterval);
+        for (int i = blockStart; i < blockEnd; i++) {
+            simulateOperation(decode[i].opId, decode[i].jobId, genes[i] - 1, machines, jobStates, data);
+        }
+    }
+    
+    chromosome.checkpoints = move(updated);
+    chromosome.dirtyFrom = numGenes;
+    assignFitness(chromosome, machines, scratch.machines.size());
+}
+
+/*
+ Evalua todas las politicas de un individuo
+ 
+ Ejecuta la evaluacion para los 6 cromosomas del individuo y
+ muestra un resumen comparativo de todas las politicas
+ 
+ individual: Individuo a evaluar completamente
+ data: Datos del escenario
+ */
+void evaluateAllPolicies(Individual& individual, const ScenarioData& data, string individuo, bool showTable = false, bool showSchedule = false) {
+    vector<vector<OperationSchedule>> allSchedules;
+    for (int i = 0; i < individual.getNumChromosomes(); i++) {
+        vector<OperationSchedule> schedule = evaluateChromosome(individual.chromosomes[i], data, showSchedule);
         allSchedules.push_back(schedule);
     }    
     vector<string> fields = {"Politica", "Makespan", "Energia"};
@@ -1024,7 +2088,7 @@ void evaluateAllPolicies(Individual& individual, const ScenarioData& data, strin
 
     for (int i = 0; i < individual.getNumChromosomes(); i++) {
         vector<string> row;
-        row.push_back(individual.chromosomes[i].policyName);
+        row.push_back(individual.chromosomes[i].getPolicyName());
         row.push_back(to_string(individual.chromosomes[i].f1));
         row.push_back(to_string(individual.chromosomes[i].f2));
         values.push_back(row);
@@ -1037,7 +2101,7 @@ void evaluateAllPolicies(Individual& individual, const ScenarioData& data, strin
         if (showSchedule) {
             for (int i = 0; i < individual.getNumChromosomes(); i++) {
             vector<OperationSchedule> schedule = allSchedules[i];
-            string policy = individual.chromosomes[i].policyName;
+            string policy = individual.chromosomes[i].getPolicyName();
             printSchedule(schedule, data, policy);
             }
         }
@@ -1045,444 +2109,4211 @@ void evaluateAllPolicies(Individual& individual, const ScenarioData& data, strin
     
 }
 
-void calculateCrowdingDistanceChromosome(vector<Individual*>& front, int chromosomeIndex) {
-    int size = front.size();
-    if (size == 0) return;
-
-    for (auto& ind : front) {
-        ind->chromosomes[chromosomeIndex].crowdingDistance = 0;
-    }
-
-    auto compareF1 = [chromosomeIndex](Individual* a, Individual* b) {
-        return a->chromosomes[chromosomeIndex].f1 < b->chromosomes[chromosomeIndex].f1;
-    };
-    auto compareF2 = [chromosomeIndex](Individual* a, Individual* b) {
-        return a->chromosomes[chromosomeIndex].f2 < b->chromosomes[chromosomeIndex].f2;
-    };
+// EVALUACION POR LOTES (SIMD)
 
-    sort(front.begin(), front.end(), compareF1);
-    front[0]->chromosomes[chromosomeIndex].crowdingDistance = numeric_limits<double>::infinity();
-    front[size - 1]->chromosomes[chromosomeIndex].crowdingDistance = numeric_limits<double>::infinity();
+// Numero de cromosomas que se simulan a la vez en un lote (un carril SIMD por cromosoma)
+const int BATCH_LANES = 8;
 
-    double f1Min = front[0]->chromosomes[chromosomeIndex].f1;
-    double f1Max = front[size - 1]->chromosomes[chromosomeIndex].f1;
+/*
+ BatchScratch
+ Estado de simulacion de un lote de BATCH_LANES cromosomas de la misma politica
+ 
+ Todos los arreglos se guardan intercalados por carril ([elemento][carril]):
+ el estado de un trabajo o maquina para los 8 cromosomas del lote queda en
+ una misma linea de cache y se puede leer o escribir como un solo vector.
+ 
+ laneMachines: Maquina (base 0) de cada gen en cada carril [gen][carril]
+ machineTime: Tiempo libre de cada maquina [maquina][carril]
+ machineEnergy: Energia acumulada de cada maquina [maquina][carril]
+ machineActive: 1.0 si la maquina recibio operaciones [maquina][carril]
+ jobTime: Fin de la ultima operacion de cada trabajo [trabajo][carril]
+ jobNextOperation: Operaciones ya programadas de cada trabajo (igual en todos los carriles)
+ laneMachineStates: Estado final de las maquinas de un carril, para calcular su fitness
+ */
+struct BatchScratch {
+    vector<int32_t> laneMachines;
+    vector<double, AlignedAllocator<double, 64>> machineTime;
+    vector<double, AlignedAllocator<double, 64>> machineEnergy;
+    vector<double, AlignedAllocator<double, 64>> machineActive;
+    vector<double, AlignedAllocator<double, 64>> jobTime;
+    vector<int> jobNextOperation;
+    vector<MachineState> laneMachineStates;
+    
+    void prepare(int numMachines, int numJobs, int numGenes) {
+        laneMachines.resize(size_t(numGenes) * BATCH_LANES);
+        machineTime.resize(size_t(numMachines) * BATCH_LANES);
+        machineEnergy.resize(size_t(numMachines) * BATCH_LANES);
+        machineActive.resize(size_t(numMachines) * BATCH_LANES);
+        jobTime.resize(size_t(numJobs) * BATCH_LANES);
+        jobNextOperation.resize(numJobs);
+        laneMachineStates.resize(numMachines);
+    }
+    
+    void reset() {
+        fill(machineTime.begin(), machineTime.end(), 0.0);
+        fill(machineEnergy.begin(), machineEnergy.end(), 0.0);
+        fill(machineActive.begin(), machineActive.end(), 0.0);
+        fill(jobTime.begin(), jobTime.end(), 0.0);
+        fill(jobNextOperation.begin(), jobNextOperation.end(), 0);
+    }
+    
+    /*
+     Copia el estado de un carril al formato de la simulacion escalar
+     */
+    void extractLane(int lane, MachineState* machines, JobState* jobStates) const {
+        for (size_t m = 0; m < laneMachineStates.size(); m++) {
+            machines[m].currentTime = machineTime[m * BATCH_LANES + lane];
+            machines[m].totalEnergy = machineEnergy[m * BATCH_LANES + lane];
+            machines[m].isActive = machineActive[m * BATCH_LANES + lane] != 0.0;
+        }
+        if (jobStates == nullptr) return;
+        for (size_t j = 0; j < jobNextOperation.size(); j++) {
+            jobStates[j].nextOperationIndex = jobNextOperation[j];
+            jobStates[j].lastOperationEndTime = jobTime[j * BATCH_LANES + lane];
+        }
+    }
+};
 
-    for (int i = 1; i < size - 1; i++) {
-        if (f1Max - f1Min == 0) continue;
-        front[i]->chromosomes[chromosomeIndex].crowdingDistance +=
-            (front[i + 1]->chromosomes[chromosomeIndex].f1 - front[i - 1]->chromosomes[chromosomeIndex].f1) / (f1Max - f1Min);
+/*
+ Simula los genes [begin, end) de los BATCH_LANES carriles de un lote en paralelo
+ 
+ Es la misma logica de simulateOperation aplicada a un vector de cromosomas:
+ el trabajo y la operacion de cada gen son comunes a todo el lote (misma
+ politica) y solo cambia la maquina de cada carril, por lo que los tiempos
+ de maquina y los costos se leen con gather y se escriben con scatter.
+ Con AVX-512 todo el lote es un vector; con AVX2 se usan dos mitades de 4
+ carriles y la escritura se hace carril a carril; sin SIMD se usa un bucle escalar.
+ (Compilar con -march=native, -mavx2 o -mavx512f para activar los caminos SIMD.)
+ */
+void simulateBatchGenes(int begin, int end, const vector<GeneDecode>& decode, const ScenarioData& data, BatchScratch& scratch) {
+    double* machineTime = scratch.machineTime.data();
+    double* machineEnergy = scratch.machineEnergy.data();
+    double* machineActive = scratch.machineActive.data();
+    double* jobTime = scratch.jobTime.data();
+    const int32_t* laneMachines = scratch.laneMachines.data();
+    
+#if defined(__AVX512F__)
+    const __m256i laneOffsets = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m512d ones = _mm512_set1_pd(1.0);
+    for (int i = begin; i < end; i++) {
+        const int opId = decode[i].opId;
+        const int jobId = decode[i].jobId;
+        __m256i machine = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(laneMachines + size_t(i) * BATCH_LANES));
+        __m256i slot = _mm256_add_epi32(_mm256_slli_epi32(machine, 3), laneOffsets);
+        
+        __m512d machineFree = _mm512_i32gather_pd(slot, machineTime, 8);
+        __m512d jobFree = _mm512_load_pd(jobTime + size_t(jobId) * BATCH_LANES);
+        __m512d duration = _mm512_i32gather_pd(machine, data.processingTime[opId], 8);
+        __m512d energy = _mm512_i32gather_pd(machine, data.energyCost[opId], 8);
+        __m512d accumulated = _mm512_i32gather_pd(slot, machineEnergy, 8);
+        
+        __m512d endTime = _mm512_add_pd(_mm512_max_pd(machineFree, jobFree), duration);
+        _mm512_i32scatter_pd(machineTime, slot, endTime, 8);
+        _mm512_i32scatter_pd(machineEnergy, slot, _mm512_add_pd(accumulated, energy), 8);
+        _mm512_i32scatter_pd(machineActive, slot, ones, 8);
+        _mm512_store_pd(jobTime + size_t(jobId) * BATCH_LANES, endTime);
+        scratch.jobNextOperation[jobId]++;
+    }
+#elif defined(__AVX2__)
+    const __m128i laneOffsets[2] = {_mm_setr_epi32(0, 1, 2, 3), _mm_setr_epi32(4, 5, 6, 7)};
+    alignas(32) int32_t slots[4];
+    alignas(32) double endLanes[4];
+    alignas(32) double energyLanes[4];
+    for (int i = begin; i < end; i++) {
+        const int opId = decode[i].opId;
+        const int jobId = decode[i].jobId;
+        for (int half = 0; half < 2; half++) {
+            const size_t laneBase = size_t(i) * BATCH_LANES + half * 4;
+            __m128i machine = _mm_loadu_si128(reinterpret_cast<const __m128i*>(laneMachines + laneBase));
+            __m128i slot = _mm_add_epi32(_mm_slli_epi32(machine, 3), laneOffsets[half]);
+            
+            __m256d machineFree = _mm256_i32gather_pd(machineTime, slot, 8);
+            double* jobLanes = jobTime + size_t(jobId) * BATCH_LANES + half * 4;
+            __m256d jobFree = _mm256_load_pd(jobLanes);
+            __m256d duration = _mm256_i32gather_pd(data.processingTime[opId], machine, 8);
+            __m256d energy = _mm256_i32gather_pd(data.energyCost[opId], machine, 8);
+            
+            __m256d endTime = _mm256_add_pd(_mm256_max_pd(machineFree, jobFree), duration);
+            _mm256_store_pd(jobLanes, endTime);
+            _mm256_store_pd(endLanes, endTime);
+            _mm256_store_pd(energyLanes, energy);
+            _mm_store_si128(reinterpret_cast<__m128i*>(slots), slot);
+            for (int lane = 0; lane < 4; lane++) {
+                machineTime[slots[lane]] = endLanes[lane];
+                machineEnergy[slots[lane]] += energyLanes[lane];
+                machineActive[slots[lane]] = 1.0;
+            }
+        }
+        scratch.jobNextOperation[jobId]++;
+    }
+#else
+    for (int i = begin; i < end; i++) {
+        const int opId = decode[i].opId;
+        const int jobId = decode[i].jobId;
+        const double* durations = data.processingTime[opId];
+        const double* energies = data.energyCost[opId];
+        double* jobLanes = jobTime + size_t(jobId) * BATCH_LANES;
+        for (int lane = 0; lane < BATCH_LANES; lane++) {
+            int machine = laneMachines[size_t(i) * BATCH_LANES + lane];
+            size_t slot = size_t(machine) * BATCH_LANES + lane;
+            double endTime = calculateStartTime(machineTime[slot], jobLanes[lane]) + durations[machine];
+            machineTime[slot] = endTime;
+            machineEnergy[slot] += energies[machine];
+            machineActive[slot] = 1.0;
+            jobLanes[lane] = endTime;
+        }
+        scratch.jobNextOperation[jobId]++;
     }
+#endif
+}
 
-    sort(front.begin(), front.end(), compareF2);
-    front[0]->chromosomes[chromosomeIndex].crowdingDistance = numeric_limits<double>::infinity();
-    front[size - 1]->chromosomes[chromosomeIndex].crowdingDistance = numeric_limits<double>::infinity();
+/*
+ Evalua el fitness de hasta BATCH_LANES cromosomas de la misma politica en un solo recorrido
+ 
+ Produce exactamente los mismos f1/f2 (y checkpoints, si checkpointInterval > 0)
+ que evaluateChromosomeFitness partiendo del tiempo cero. Los carriles sin
+ cromosoma repiten el primero y sus resultados se descartan.
+ 
+ chromosomes: Cromosomas a evaluar (todos de la misma politica y tamaño del escenario)
+ count: Numero de cromosomas (1..BATCH_LANES)
+ data: Datos del escenario
+ scratch: Estado del lote, preparado para el escenario
+ checkpointInterval: Genes entre checkpoints (0 para no guardarlos)
+ */
+void evaluateChromosomeBatch(Chromosome* const* chromosomes, int count, const ScenarioData& data, BatchScratch& scratch, int checkpointInterval = 0) {
+    const vector<GeneDecode>& decode = data.decodeTables[chromosomes[0]->policy];
+    const int numGenes = data.totalOperations;
+    
+    // Transponer los genes del lote a [gen][carril]
+    for (int lane = 0; lane < BATCH_LANES; lane++) {
+        const Gene* genes = chromosomes[lane < count ? lane : 0]->genes;
+        for (int i = 0; i < numGenes; i++) {
+            scratch.laneMachines[size_t(i) * BATCH_LANES + lane] = genes[i] - 1;
+        }
+    }
+    scratch.reset();
+    
+    bool useCheckpoints = checkpointInterval > 0 && checkpointInterval < numGenes;
+    int blockSize = useCheckpoints ? checkpointInterval : numGenes;
+    vector<shared_ptr<SimulationCheckpoints>> updated;
+    if (useCheckpoints) {
+        for (int lane = 0; lane < count; lane++) {
+            updated.push_back(make_shared<SimulationCheckpoints>());
+            updated.back()->interval = checkpointInterval;
+        }
+    }
+    
+    for (int blockStart = 0; blockStart < numGenes; blockStart += blockSize) {
+        if (blockStart > 0) {
+            for (int lane = 0; lane < count; lane++) {
+                auto snapshot = make_shared<SimulationSnapshot>();
+                snapshot->machines.resize(data.numMachines);
+                snapshot->jobStates.resize(data.numJobs);
+                scratch.extractLane(lane, snapshot->machines.data(), snapshot->jobStates.data());
+                updated[lane]->snapshots.push_back(move(snapshot));
+            }
+        }
+        simulateBatchGenes(blockStart, min(numGenes, blockStart + blockSize), decode, data, scratch);
+    }
+    
+    for (int lane = 0; lane < count; lane++) {
+        Chromosome& chromosome = *chromosomes[lane];
+        if (useCheckpoints) {
+            chromosome.checkpoints = move(updated[lane]);
+            chromosome.dirtyFrom = numGenes;
+        }
+        scratch.extractLane(lane, scratch.laneMachineStates.data(), nullptr);
+        assignFitness(chromosome, scratch.laneMachineStates.data(), scratch.laneMachineStates.size());
+    }
+}
 
-    double f2Min = front[0]->chromosomes[chromosomeIndex].f2;
-    double f2Max = front[size - 1]->chromosomes[chromosomeIndex].f2;
+/*
+ Calcula los genes entre checkpoints para tener hasta checkpointsPerChromosome por cromosoma
+ 
+ Cada checkpoint copia el estado de todas las maquinas y trabajos, asi que
+ el intervalo nunca es menor a 2 * (maquinas + trabajos) genes: de lo
+ contrario guardar los checkpoints costaria mas que la simulacion que ahorran.
+ Vienen desactivados por defecto (--checkpoints N los activa): cada
+ evaluacion con checkpoints reserva sus snapshots, lo que anula el camino
+ de evaluacion sin reservas de memoria.
+ int: Intervalo en genes (0 si no conviene usar checkpoints)
+ */
+int checkpointIntervalFor(const ScenarioData& data, int checkpointsPerChromosome) {
+    const int MIN_CHECKPOINT_INTERVAL = 32;
+    if (checkpointsPerChromosome <= 0) return 0;
+    int interval = max({MIN_CHECKPOINT_INTERVAL,
+                        data.totalOperations / (checkpointsPerChromosome + 1),
+                        2 * (data.numMachines + data.numJobs)});
+    return interval < data.totalOperations ? interval : 0;
+}
 
-    for (int i = 1; i < size - 1; i++) {
-        if (f2Max - f2Min == 0) continue;
-        front[i]->chromosomes[chromosomeIndex].crowdingDistance +=
-            (front[i + 1]->chromosomes[chromosomeIndex].f2 - front[i - 1]->chromosomes[chromosomeIndex].f2) / (f2Max - f2Min);
-    }
-}
-
-void fastNonDominatedSort(vector<Individual>& population) {
-    for (int c = 0; c < population[0].getNumChromosomes();c++){
-        int rank = 0;
-        vector<Individual*> dominatedIndividuals;
-        vector<Individual*> dominatedIndividualsTemp;
-        for (auto& ind : population) {
-            dominatedIndividuals.push_back(&ind); 
-        }
-        while (!dominatedIndividuals.empty()) {
-            rank++;
-            for (size_t i = 0; i < dominatedIndividuals.size(); ++i) {
-                bool isDominated = false;
-                for (size_t j = 0; j < dominatedIndividuals.size(); ++j) {
-                    if (i == j) continue;
-                    auto& A = dominatedIndividuals[j]; // posible dominante
-                    auto& B = dominatedIndividuals[i]; // posible dominado
-
-                    bool betterOrEqualInAll =
-                        A->chromosomes[c].f1 <= B->chromosomes[c].f1 &&
-                        A->chromosomes[c].f2 <= B->chromosomes[c].f2;
-
-                    bool strictlyBetterInAtLeastOne =
-                        A->chromosomes[c].f1 < B->chromosomes[c].f1 ||
-                        A->chromosomes[c].f2 < B->chromosomes[c].f2;
-
-                    if (betterOrEqualInAll && strictlyBetterInAtLeastOne) {
-                        isDominated = true;
-                        break;
-                    }
-                }
+// EVALUACION PARALELA DE LA POBLACION
 
-                if (isDominated)
-                    dominatedIndividualsTemp.push_back(dominatedIndividuals[i]);
-                else
-                    dominatedIndividuals[i]->chromosomes[c].domLevel = rank;
+/*
+ ThreadPool
+ Conjunto fijo de hilos de trabajo para ejecutar bucles paralelos
+ 
+ Los hilos se crean una sola vez y esperan trabajo entre llamadas. El hilo
+ que llama a parallelFor participa como trabajador 0, por lo que un pool de
+ un solo hilo ejecuta todo de forma secuencial sin crear hilos adicionales.
+ parallelFor no debe llamarse desde dentro de una tarea del mismo pool.
+ 
+ numThreads: Numero total de trabajadores (incluido el hilo que llama)
+ */
+class ThreadPool {
+public:
+    explicit ThreadPool(int numThreads) : numThreads(max(1, numThreads)) {
+        for (int w = 1; w < this->numThreads; w++) {
+            workers.emplace_back([this, w]() { workerLoop(w); });
+        }
+    }
+    
+    ~ThreadPool() {
+        {
+            lock_guard<mutex> lock(stateMutex);
+            stopping = true;
+        }
+        workAvailable.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    int size() const {
+        return numThreads;
+    }
+    
+    /*
+     Ejecuta task(index, workerId) para cada index en [0, count)
+     
+     Los indices se reparten dinamicamente entre los trabajadores. workerId
+     esta en [0, size()) y permite a cada tarea usar memoria propia del hilo.
+     Si alguna tarea lanza una excepcion, se relanza aqui al terminar.
+     */
+    void parallelFor(size_t count, const function<void(size_t, int)>& task) {
+        if (count == 0) return;
+        if (numThreads == 1 || count == 1) {
+            for (size_t i = 0; i < count; i++) {
+                task(i, 0);
             }
-            dominatedIndividuals = dominatedIndividualsTemp;
-            dominatedIndividualsTemp.clear();
+            return;
         }
-        for (int r = 1; r <= rank; r++) {
-            vector<Individual*> front;
-            for (auto& ind : population) {
-                if (ind.chromosomes[c].domLevel == r) {
-                    front.push_back(&ind);
-                }
+        {
+            lock_guard<mutex> lock(stateMutex);
+            currentTask = &task;
+            taskCount = count;
+            nextIndex = 0;
+            activeWorkers = numThreads - 1;
+            firstError = nullptr;
+            generation++;
+        }
+        workAvailable.notify_all();
+        
+        runTasks(0);
+        
+        unique_lock<mutex> lock(stateMutex);
+        workDone.wait(lock, [this]() { return activeWorkers == 0; });
+        currentTask = nullptr;
+        if (firstError) {
+            rethrow_exception(firstError);
+        }
+    }
+    
+private:
+    int numThreads;
+    vector<thread> workers;
+    mutex stateMutex;
+    condition_variable workAvailable;
+    condition_variable workDone;
+    const function<void(size_t, int)>* currentTask = nullptr;
+    size_t taskCount = 0;
+    atomic<size_t> nextIndex{0};
+    int activeWorkers = 0;
+    unsigned long long generation = 0;
+    bool stopping = false;
+    exception_ptr firstError;
+    
+    void runTasks(int workerId) {
+        size_t index;
+        while ((index = nextIndex.fetch_add(1, memory_order_relaxed)) < taskCount) {
+            try {
+                (*currentTask)(index, workerId);
+            } catch (...) {
+                lock_guard<mutex> lock(stateMutex);
+                if (!firstError) firstError = current_exception();
+            }
+        }
+    }
+    
+    void workerLoop(int workerId) {
+        unsigned long long seenGeneration = 0;
+        while (true) {
+            {
+                unique_lock<mutex> lock(stateMutex);
+                workAvailable.wait(lock, [&]() { return stopping || generation != seenGeneration; });
+                if (stopping) return;
+                seenGeneration = generation;
             }
-            calculateCrowdingDistanceChromosome(front, c);
+            runTasks(workerId);
+            {
+                lock_guard<mutex> lock(stateMutex);
+                activeWorkers--;
+            }
+            workDone.notify_one();
         }
     }
+};
+
+/*
+ GenomeKey
+ Huella de 128 bits de los genes de un cromosoma junto con su politica
+ 
+ hash: Valor usado para ubicar la entrada en la cache
+ check: Segundo hash independiente para descartar colisiones de hash
+ */
+struct GenomeKey {
+    uint64_t hash;
+    uint64_t check;
+};
+
+/*
+ Calcula la huella de un cromosoma (politica + genes) para la cache de fitness
+ 
+ Usa dos acumuladores con constantes distintas y un mezclado final, de modo
+ que dos cromosomas distintos solo compartan clave con probabilidad ~2^-128.
+ Los genes empaquetados se consumen de a 8 bytes por ronda.
+ */
+GenomeKey computeGenomeKey(int policy, const Gene* genes, size_t size) {
+    auto mix = [](uint64_t x) {
+        x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27; x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return x;
+    };
+    uint64_t a = 0x9e3779b97f4a7c15ULL ^ uint64_t(policy);
+    uint64_t b = 0xc2b2ae3d27d4eb4fULL + uint64_t(size);
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(genes);
+    const size_t numBytes = size * sizeof(Gene);
+    for (size_t i = 0; i < numBytes; i += 8) {
+        uint64_t word = 0;
+        memcpy(&word, bytes + i, min<size_t>(8, numBytes - i));
+        a = (a ^ word) * 0x100000001b3ULL;
+        b = ((b << 7) | (b >> 57)) ^ (word * 0x9ddfea08eb382d69ULL);
+    }
+    return {mix(a ^ (b >> 17)), mix(b + uint64_t(policy) * 0xff51afd7ed558ccdULL)};
 }
 
-Individual tournamentSelection(const vector<Individual>& population) {
-    int index1 = rand() % population.size();
-    int index2 = rand() % population.size();
-    const Individual& A = population[index1];
-    const Individual& B = population[index2];
-    Individual superIndividual;
-    for(int c=0; c<A.getNumChromosomes(); c++){
-        if (A.chromosomes[c].domLevel < B.chromosomes[c].domLevel){
-            for(int j=0; j<A.chromosomes[c].genes.size(); j++){
-                superIndividual.chromosomes[c].genes.push_back(A.chromosomes[c].genes[j]);
+/*
+ FitnessCache
+ Cache acotada y segura para hilos de (politica, genes) -> (makespan, energia)
+ 
+ Las entradas se reparten en particiones con su propio mutex para que los
+ hilos de evaluacion no compitan por un unico candado. Cada particion
+ descarta sus entradas mas antiguas (FIFO) al superar su capacidad.
+ 
+ capacity: Numero maximo aproximado de entradas
+ hits / misses: Contadores de aciertos y fallos
+ */
+class FitnessCache {
+public:
+    explicit FitnessCache(size_t capacity) : shards(NUM_SHARDS), hits(0), misses(0) {
+        shardCapacity = max<size_t>(1, capacity / NUM_SHARDS);
+    }
+    
+    /*
+     Busca el fitness de un cromosoma
+     
+     key: Huella del cromosoma (computeGenomeKey)
+     f1, f2: Salida, fitness almacenado si hubo acierto
+     bool: true si el cromosoma estaba en la cache
+     */
+    bool lookup(const GenomeKey& key, double& f1, double& f2) {
+        Shard& shard = shardFor(key);
+        {
+            lock_guard<mutex> lock(shard.lock);
+            auto it = shard.entries.find(key.hash);
+            if (it != shard.entries.end() && it->second.check == key.check) {
+                f1 = it->second.f1;
+                f2 = it->second.f2;
+                hits.fetch_add(1, memory_order_relaxed);
+                return true;
+            }
+        }
+        misses.fetch_add(1, memory_order_relaxed);
+        return false;
+    }
+    
+    /*
+     Guarda el fitness de un cromosoma recien evaluado
+     */
+    void store(const GenomeKey& key, double f1, double f2) {
+        Shard& shard = shardFor(key);
+        lock_guard<mutex> lock(shard.lock);
+        auto inserted = shard.entries.insert({key.hash, Entry{key.check, f1, f2}});
+        if (!inserted.second) {
+            inserted.first->second = Entry{key.check, f1, f2};
+            return;
+        }
+        shard.insertionOrder.push_back(key.hash);
+        while (shard.entries.size() > shardCapacity) {
+            shard.entries.erase(shard.insertionOrder.front());
+            shard.insertionOrder.pop_front();
+        }
+    }
+    
+    uint64_t getHits() const { return hits.load(); }
+    uint64_t getMisses() const { return misses.load(); }
+    
+private:
+    static const size_t NUM_SHARDS = 16;
+    
+    struct Entry {
+        uint64_t check;
+        double f1;
+        double f2;
+    };
+    
+    struct Shard {
+        mutex lock;
+        unordered_map<uint64_t, Entry> entries;
+        deque<uint64_t> insertionOrder;
+    };
+    
+    vector<Shard> shards;
+    size_t shardCapacity;
+    atomic<uint64_t> hits;
+    atomic<uint64_t> misses;
+    
+    Shard& shardFor(const GenomeKey& key) {
+        return shards[key.hash >> 60];
+    }
+};
+
+/*
+ PopulationEvaluator
+ Evalua el fitness de poblaciones completas repartiendo el trabajo entre
+ los hilos de un ThreadPool
+ 
+ Solo se evaluan los cromosomas modificados (dirty). Si se indica una
+ FitnessCache, los cromosomas repetidos toman su fitness de ella en lugar
+ de volver a simularse. Los que deben simularse desde el tiempo cero se
+ agrupan por politica en lotes de BATCH_LANES (evaluateChromosomeBatch) y
+ los que pueden reanudarse desde un checkpoint se simulan uno a uno. Cada
+ hilo usa su propio estado de simulacion, sin reservar memoria ni compartir
+ estado mutable entre hilos.
+ 
+ data: Datos del escenario
+ pool: Hilos de trabajo
+ cache: Cache de fitness (opcional, nullptr para simular siempre)
+ checkpointInterval: Genes entre checkpoints de simulacion (0 para no usarlos)
+ useBatches: Agrupa en lotes SIMD los cromosomas que se simulan desde cero
+ 
+ Los lotes solo compensan con AVX-512 y escenarios de pocas maquinas: la
+ simulacion es una cadena de lecturas y escrituras dependientes, no calculo,
+ por lo que vienen desactivados por defecto (--batch para activarlos).
+ 
+ Cuenta como una evaluacion cada individuo con algun cromosoma modificado,
+ lo resuelva la cache o la simulacion (getEvaluations).
+ */
+class PopulationEvaluator {
+public:
+    PopulationEvaluator(const ScenarioData& data, ThreadPool& pool, FitnessCache* cache = nullptr,
+                        int checkpointInterval = 0, bool useBatches = false)
+        : data(data), pool(pool), cache(cache), checkpointInterval(checkpointInterval), useBatches(useBatches), evaluations(0) {
+        scratch.resize(pool.size());
+        for (auto& workerScratch : scratch) {
+            workerScratch.prepare(data.numMachines, data.numJobs);
+        }
+        if (useBatches) {
+            batchScratch.resize(pool.size());
+            for (auto& workerScratch : batchScratch) {
+                workerScratch.prepare(data.numMachines, data.numJobs, data.totalOperations);
             }
         }
-        else if (B.chromosomes[c].domLevel < A.chromosomes[c].domLevel){
-            for(int j=0; j<B.chromosomes[c].genes.size(); j++){
-                superIndividual.chromosomes[c].genes.push_back(B.chromosomes[c].genes[j]);
+    }
+    
+    /*
+     Evalua f1 y f2 de los cromosomas modificados (dirty) de todos los individuos
+     
+     Los cromosomas cuyo fitness sigue vigente no se vuelven a simular.
+     */
+    void evaluate(Population& population) {
+        pending.clear();
+        for (auto& individual : population) {
+            if (individual.isDirty()) evaluations++;
+            for (auto& chromosome : individual.chromosomes) {
+                if (chromosome.dirty) {
+                    pending.push_back(&chromosome);
+                }
             }
         }
-        else {
-            if (A.chromosomes[c].crowdingDistance > B.chromosomes[c].crowdingDistance){
-                for(int j=0; j<A.chromosomes[c].genes.size(); j++){
-                    superIndividual.chromosomes[c].genes.push_back(A.chromosomes[c].genes[j]);
+        
+        // Consultar la cache; los aciertos quedan evaluados
+        if (cache != nullptr) {
+            keys.resize(pending.size());
+            pool.parallelFor(pending.size(), [&](size_t task, int) {
+                Chromosome& chromosome = *pending[task];
+                keys[task] = computeGenomeKey(chromosome.policy, chromosome.genes, chromosome.size());
+                if (cache->lookup(keys[task], chromosome.f1, chromosome.f2)) {
+                    chromosome.markClean();
+                }
+            });
+        }
+        
+        // Agrupar por politica los cromosomas que se simulan desde cero; los
+        // genomas repetidos dentro de la misma llamada se simulan una sola vez
+        order.clear();
+        tasks.clear();
+        duplicates.clear();
+        firstWithKey.clear();
+        vector<vector<int>> fullReplays(policyNames.size());
+        for (size_t t = 0; t < pending.size(); t++) {
+            const Chromosome& chromosome = *pending[t];
+            if (!chromosome.dirty) continue;
+            if (cache != nullptr) {
+                auto inserted = firstWithKey.emplace(keys[t].hash, t);
+                if (!inserted.second && keys[inserted.first->second].check == keys[t].check) {
+                    duplicates.push_back({int(t), inserted.first->second});
+                    continue;
                 }
+            }
+            if (useBatches && chromosome.size() == data.totalOperations && !canResume(chromosome)) {
+                fullReplays[chromosome.policy].push_back(t);
+            } else {
+                tasks.push_back({int(order.size()), 1});
+                order.push_back(t);
+            }
+        }
+        for (const auto& group : fullReplays) {
+            for (size_t first = 0; first < group.size(); first += BATCH_LANES) {
+                int count = min<size_t>(BATCH_LANES, group.size() - first);
+                tasks.push_back({int(order.size()), count});
+                order.insert(order.end(), group.begin() + first, group.begin() + first + count);
+            }
+        }
+        
+        pool.parallelFor(tasks.size(), [&](size_t task, int workerId) {
+            const EvaluationTask& current = tasks[task];
+            Chromosome* batch[BATCH_LANES];
+            for (int lane = 0; lane < current.count; lane++) {
+                batch[lane] = pending[order[current.first + lane]];
+            }
+            if (current.count == 1) {
+                evaluateChromosomeFitness(*batch[0], data, scratch[workerId], checkpointInterval);
             } else {
-                for(int j=0; j<B.chromosomes[c].genes.size(); j++){
-                    superIndividual.chromosomes[c].genes.push_back(B.chromosomes[c].genes[j]);
+                evaluateChromosomeBatch(batch, current.count, data, batchScratch[workerId], checkpointInterval);
+            }
+            if (cache != nullptr) {
+                for (int lane = 0; lane < current.count; lane++) {
+                    cache->store(keys[order[current.first + lane]], batch[lane]->f1, batch[lane]->f2);
                 }
             }
+        });
+        
+        for (const auto& duplicate : duplicates) {
+            Chromosome& chromosome = *pending[duplicate.first];
+            chromosome.f1 = pending[duplicate.second]->f1;
+            chromosome.f2 = pending[duplicate.second]->f2;
+            chromosome.markClean();
         }
     }
-    return superIndividual;
-}
-
-vector<Individual> selectParents(const vector<Individual>& population, int numParents) {
-    vector<Individual> parents;
-    parents.reserve(numParents);
     
-    for (int i = 0; i < numParents; i++) {
-        Individual parent = tournamentSelection(population);
-        parents.push_back(parent);
+    // Individuos evaluados desde que se creo el evaluador
+    long getEvaluations() const {
+        return evaluations;
     }
-    return parents;
-}
-
-vector<Individual> uniformCrossover(const Individual& parent1, const Individual& parent2, mt19937& rng, float crossoverRate,  uniform_real_distribution<double>& dist) {
-    Individual offspring1;
-    Individual offspring2;
     
-    if (dist(rng) < crossoverRate){
-        for (int i = 0; i < parent1.chromosomes[0].genes.size(); i++) {
-            if (dist(rng) < 0.5){
-                for(int j = 0; j < parent1.getNumChromosomes(); j++){
-                    offspring1.chromosomes[j].genes.push_back(parent1.chromosomes[j].genes[i]);
-                    offspring2.chromosomes[j].genes.push_back(parent2.chromosomes[j].genes[i]);
-                }
-            } else {
-                for(int j = 0; j < parent1.getNumChromosomes(); j++){
-                    offspring1.chromosomes[j].genes.push_back(parent2.chromosomes[j].genes[i]);
-                    offspring2.chromosomes[j].genes.push_back(parent1.chromosomes[j].genes[i]);
-                }
+private:
+    // Grupo de cromosomas de order[first, first + count) que evalua un mismo hilo
+    struct EvaluationTask {
+        int first;
+        int count;
+    };
+    
+    const ScenarioData& data;
+    ThreadPool& pool;
+    FitnessCache* cache;
+    int checkpointInterval;
+    bool useBatches;
+    long evaluations;
+    vector<EvaluationScratch> scratch;
+    vector<BatchScratch> batchScratch;
+    vector<Chromosome*> pending;
+    vector<GenomeKey> keys;
+    vector<int> order;
+    vector<EvaluationTask> tasks;
+    vector<pair<int, int>> duplicates;
+    unordered_map<uint64_t, int> firstWithKey;
+    
+    bool canResume(const Chromosome& chromosome) const {
+        return checkpointInterval > 0 && chromosome.checkpoints &&
+               chromosome.checkpoints->interval == checkpointInterval &&
+               chromosome.checkpoints->validBefore(chromosome.dirtyFrom) > 0;
+    }
+};
+
+/*
+ Evalua los cromosomas modificados de un solo individuo, consultando la cache
+ 
+ Para quien reparte individuos entre hilos por su cuenta (sin PopulationEvaluator).
+ 
+ individual: Individuo a evaluar
+ data: Datos del escenario
+ scratch: Estado de simulacion propio del hilo que evalua
+ cache: Cache de fitness (opcional, nullptr para simular siempre)
+ checkpointInterval: Genes entre checkpoints de simulacion (0 para no usarlos)
+ */
+void evaluateIndividual(Individual& individual, const ScenarioData& data, EvaluationScratch& scratch, FitnessCache* cache, int checkpointInterval) {
+    for (auto& chromosome : individual.chromosomes) {
+        if (!chromosome.dirty) continue;
+        GenomeKey key;
+        if (cache != nullptr) {
+            key = computeGenomeKey(chromosome.policy, chromosome.genes, chromosome.size());
+            if (cache->lookup(key, chromosome.f1, chromosome.f2)) {
+                chromosome.markClean();
+                continue;
             }
         }
-    } else {
-        offspring1 = parent1;
-        offspring2 = parent2;
+        evaluateChromosomeFitness(chromosome, data, scratch, checkpointInterval);
+        if (cache != nullptr) {
+            cache->store(key, chromosome.f1, chromosome.f2);
+        }
     }
-    return {offspring1, offspring2};
 }
 
-vector<Individual> uniformCrossoverPopulation(const vector<Individual>& parents, mt19937& rng, float crossoverRate, uniform_real_distribution<double> dist) {
-    vector<Individual> offspring;
-    offspring.reserve(parents.size());
-    
-    for (size_t i = 0; i < parents.size(); i += 2) {
-        const Individual& parent1 = parents[i];
-        const Individual& parent2 = parents[(i + 1) % parents.size()];
-        
-        vector<Individual> children = uniformCrossover(parent1, parent2, rng, crossoverRate, dist);
-        offspring.push_back(children[0]);
-        offspring.push_back(children[1]);
+/*
+ Calcula la distancia de crowding de un frente dentro de una capa de cromosomas
+ 
+ population: Poblacion a la que pertenece el frente
+ front: Indices de los individuos del frente (se reordena)
+ chromosomeIndex: Capa (politica) del frente
+ */
+void calculateCrowdingDistanceChromosome(Population& population, vector<int>& front, int chromosomeIndex) {
+    int size = front.size();
+    if (size == 0) return;
+    auto layer = [&population, chromosomeIndex](int index) -> Chromosome& {
+        return population[index].chromosomes[chromosomeIndex];
+    };
+
+    for (int index : front) {
+        layer(index).crowdingDistance = 0;
+    }
+
+    auto compareF1 = [&layer](int a, int b) {
+        return layer(a).f1 < layer(b).f1;
+    };
+    auto compareF2 = [&layer](int a, int b) {
+        return layer(a).f2 < layer(b).f2;
+    };
+
+    sort(front.begin(), front.end(), compareF1);
+    layer(front[0]).crowdingDistance = numeric_limits<double>::infinity();
+    layer(front[size - 1]).crowdingDistance = numeric_limits<double>::infinity();
+
+    double f1Min = layer(front[0]).f1;
+    double f1Max = layer(front[size - 1]).f1;
+
+    for (int i = 1; i < size - 1; i++) {
+        if (f1Max - f1Min == 0) continue;
+        layer(front[i]).crowdingDistance +=
+            (layer(front[i + 1]).f1 - layer(front[i - 1]).f1) / (f1Max - f1Min);
+    }
+
+    sort(front.begin(), front.end(), compareF2);
+    layer(front[0]).crowdingDistance = numeric_limits<double>::infinity();
+    layer(front[size - 1]).crowdingDistance = numeric_limits<double>::infinity();
+
+    double f2Min = layer(front[0]).f2;
+    double f2Max = layer(front[size - 1]).f2;
+
+    for (int i = 1; i < size - 1; i++) {
+        if (f2Max - f2Min == 0) continue;
+        layer(front[i]).crowdingDistance +=
+            (layer(front[i + 1]).f2 - layer(front[i - 1]).f2) / (f2Max - f2Min);
     }
-    
-    return offspring;
 }
 
-vector<Individual> selectSurvivors(const vector<Individual>& combinedPopulation, int desiredSize) {
-    vector<Individual> newPopulation;
-    newPopulation.reserve(desiredSize);
-    for(int i = 0; i<desiredSize; i++){
-        Individual superIndividual = tournamentSelection(combinedPopulation);
-        newPopulation.push_back(superIndividual);
+/*
+ Asigna el nivel de dominancia (domLevel) de una capa de cromosomas en O(N log N)
+ 
+ Para dos objetivos basta recorrer los cromosomas ordenados por (f1, f2):
+ todos los ya visitados tienen f1 menor o igual, por lo que un frente domina
+ al actual si y solo si su ultimo miembro (el de menor f2) lo domina. Como
+ un frente posterior solo puede dominar a quien ya domina uno anterior, el
+ primer frente que no lo domina se encuentra con busqueda binaria.
+ 
+ population: Poblacion a clasificar
+ chromosomeIndex: Capa (politica) a clasificar
+ fronts: Salida, frentes en orden de nivel con los indices de los individuos en orden creciente
+ */
+void assignDominanceLevels(Population& population, int chromosomeIndex, vector<vector<int>>& fronts) {
+    const int c = chromosomeIndex;
+    vector<int> order(population.size());
+    iota(order.begin(), order.end(), 0);
+    sort(order.begin(), order.end(), [&](int a, int b) {
+        const Chromosome& A = population[a].chromosomes[c];
+        const Chromosome& B = population[b].chromosomes[c];
+        return A.f1 < B.f1 || (A.f1 == B.f1 && A.f2 < B.f2);
+    });
+    
+    // frontLast[k]: ultimo cromosoma agregado al frente k (el de menor f2)
+    vector<const Chromosome*> frontLast;
+    for (int index : order) {
+        Chromosome& current = population[index].chromosomes[c];
+        auto dominatedBy = [&current](const Chromosome* last) {
+            return last->f2 < current.f2 || (last->f2 == current.f2 && last->f1 < current.f1);
+        };
+        int low = 0;
+        int high = frontLast.size();
+        while (low < high) {
+            int mid = (low + high) / 2;
+            if (dominatedBy(frontLast[mid])) low = mid + 1;
+            else high = mid;
+        }
+        if (low == static_cast<int>(frontLast.size())) {
+            frontLast.push_back(&current);
+        } else {
+            frontLast[low] = &current;
+        }
+        current.domLevel = low + 1;
+    }
+    
+    fronts.assign(frontLast.size(), {});
+    for (size_t i = 0; i < population.size(); i++) {
+        fronts[population[i].chromosomes[c].domLevel - 1].push_back(i);
+    }
+}
+
+/*
+ Clasifica por dominancia y calcula el crowding de cada capa de cromosomas
+ 
+ Cada capa (politica) es independiente: usa sus propios arreglos de indices
+ y solo escribe en su cromosoma de cada individuo, por lo que con un pool
+ las capas se procesan en paralelo.
+ 
+ population: Poblacion a clasificar
+ pool: Hilos de trabajo (opcional, nullptr para procesar las capas en secuencia)
+ firstFronts: Si no es nullptr, recibe por capa los indices del primer frente
+     en orden de f1 creciente (listos para frontHypervolume)
+ */
+void fastNonDominatedSort(Population& population, ThreadPool* pool = nullptr, vector<vector<int>>* firstFronts = nullptr) {
+    auto sortLayer = [&population, firstFronts](size_t c, int) {
+        vector<vector<int>> fronts;
+        assignDominanceLevels(population, c, fronts);
+        for (auto& front : fronts) {
+            calculateCrowdingDistanceChromosome(population, front, c);
+        }
+        if (firstFronts != nullptr) {
+            // El crowding deja el frente por f2 creciente; en el primer frente eso es f1 decreciente
+            vector<int>& first = (*firstFronts)[c];
+            first.clear();
+            if (!fronts.empty()) first.assign(fronts[0].rbegin(), fronts[0].rend());
+        }
+    };
+    size_t numChromosomes = population[0].getNumChromosomes();
+    if (firstFronts != nullptr) {
+        firstFronts->resize(numChromosomes);
+    }
+    if (pool != nullptr) {
+        pool->parallelFor(numChromosomes, sortLayer);
+    } else {
+        for (size_t c = 0; c < numChromosomes; c++) {
+            sortLayer(c, 0);
+        }
+    }
+}
+
+// ARCHIVO EXTERNO DE PARETO
+
+/*
+ ParetoArchive
+ Mejores soluciones no dominadas encontradas en toda la corrida, por capa (politica)
+ 
+ Cada capa guarda su frente en un vector ordenado por f1 creciente (y por
+ lo tanto f2 decreciente), de modo que saber si un punto nuevo esta
+ dominado cuesta una busqueda binaria: basta compararlo con el vecino de
+ menor f1. Si entra, los puntos que domina forman un tramo contiguo justo
+ despues de su posicion. Cuando una capa supera su capacidad se descarta el
+ punto de menor crowding (los extremos nunca se descartan).
+ 
+ Solo el rechazo es O(log n). Un punto que entra cuesta O(n): borrar el
+ tramo dominado e insertar desplazan el vector, y con la capa llena la
+ poda recorre el frente completo para recalcular el crowding (que depende
+ del rango del frente). Con la capacidad por defecto (64 entradas de 24
+ bytes) eso es mover a lo sumo 1.5 KB contiguos, y el vector permite
+ el acceso por posicion en orden de f1 que usan los reportes y el formato
+ de intercambio. Para capacidades grandes convendria un arbol por f1 con un
+ indice por crowding, como en ContributionFronts.
+ 
+ Cada entrada guarda una copia del individuo completo en el que aparecio el
+ cromosoma, porque los reportes evaluan todas las politicas del individuo.
+ Solo el fitness de la capa archivada es confiable: los demas cromosomas
+ pueden haber quedado sin evaluar.
+ 
+ numGenes: Genes por cromosoma
+ capacity: Maximo de puntos por capa
+ */
+class ParetoArchive {
+public:
+    ParetoArchive(int numGenes, int capacity) : numGenes(numGenes), capacity(max(2, capacity)) {
+        for (auto& layer : layers) {
+            layer.storage = Population(this->capacity + 1, numGenes);
+            for (int slot = this->capacity; slot >= 0; slot--) {
+                layer.freeSlots.push_back(slot);
+            }
+        }
+    }
+    
+    /*
+     Ofrece al archivo el cromosoma de una capa de un individuo evaluado
+     
+     individual: Individuo al que pertenece el cromosoma
+     c: Capa (politica) del cromosoma
+     bool: true si el punto entro al archivo
+     */
+    bool offer(const Individual& individual, int c) {
+        const Chromosome& chromosome = individual.chromosomes[c];
+        if (chromosome.dirty) return false;
+        const double f1 = chromosome.f1;
+        const double f2 = chromosome.f2;
+        Layer& layer = layers[c];
+        vector<Entry>& front = layer.front;
+        
+        auto position = lower_bound(front.begin(), front.end(), f1,
+                                    [](const Entry& entry, double value) { return entry.f1 < value; });
+        if (position != front.begin() && prev(position)->f2 <= f2) return false;
+        if (position != front.end() && position->f1 == f1 && position->f2 <= f2) return false;
+        
+        auto dominatedEnd = position;
+        while (dominatedEnd != front.end() && dominatedEnd->f2 >= f2) {
+            layer.freeSlots.push_back(dominatedEnd->slot);
+            ++dominatedEnd;
+        }
+        position = front.erase(position, dominatedEnd);
+        
+        int slot = layer.freeSlots.back();
+        layer.freeSlots.pop_back();
+        Individual& copy = layer.storage[slot];
+        copy.copyFrom(individual);
+        for (auto& stored : copy.chromosomes) {
+            stored.checkpoints.reset();
+        }
+        front.insert(position, Entry{f1, f2, slot});
+        
+        if (static_cast<int>(front.size()) > capacity) {
+            pruneMostCrowded(layer);
+        }
+        return true;
+    }
+    
+    /*
+     Ofrece todos los cromosomas evaluados de un individuo (uno por capa)
+     */
+    void offer(const Individual& individual) {
+        for (int c = 0; c < NUM_POLICIES; c++) {
+            offer(individual, c);
+        }
+    }
+    
+    /*
+     Ofrece todos los cromosomas evaluados de una poblacion, individuo por individuo
+     */
+    void update(const Population& population) {
+        for (const Individual& individual : population) {
+            offer(individual);
+        }
+    }
+    
+    /*
+     Agrega los puntos de otro archivo (con el mismo numero de genes)
+     */
+    void merge(const ParetoArchive& other) {
+        for (int c = 0; c < NUM_POLICIES; c++) {
+            for (size_t k = 0; k < other.size(c); k++) {
+                offer(other.entry(c, k), c);
+            }
+        }
+    }
+    
+    int getNumGenes() const {
+        return numGenes;
+    }
+    
+    // Puntos archivados en una capa
+    size_t size(int c) const {
+        return layers[c].front.size();
+    }
+    
+    /*
+     Individuo del k-esimo punto de una capa (en orden de f1 creciente)
+     Su cromosoma de la capa c tiene el fitness archivado.
+     */
+    Individual& entry(int c, size_t k) {
+        return layers[c].storage[layers[c].front[k].slot];
+    }
+    
+    const Individual& entry(int c, size_t k) const {
+        return layers[c].storage[layers[c].front[k].slot];
+    }
+    
+private:
+    struct Entry {
+        double f1;
+        double f2;
+        int slot; // Posicion del individuo en storage
+    };
+    
+    struct Layer {
+        vector<Entry> front;
+        Population storage;
+        vector<int> freeSlots;
+    };
+    
+    int numGenes;
+    int capacity;
+    array<Layer, NUM_POLICIES> layers;
+    
+    // Descarta el punto interior de menor crowding de una capa (recorre el frente: O(n))
+    void pruneMostCrowded(Layer& layer) {
+        vector<Entry>& front = layer.front;
+        const int size = front.size();
+        double f1Range = front[size - 1].f1 - front[0].f1;
+        double f2Range = front[0].f2 - front[size - 1].f2;
+        int mostCrowded = 1;
+        double minDistance = numeric_limits<double>::infinity();
+        for (int i = 1; i < size - 1; i++) {
+            double distance = 0;
+            if (f1Range > 0) distance += (front[i + 1].f1 - front[i - 1].f1) / f1Range;
+            if (f2Range > 0) distance += (front[i - 1].f2 - front[i + 1].f2) / f2Range;
+            if (distance < minDistance) {
+                minDistance = distance;
+                mostCrowded = i;
+            }
+        }
+        layer.freeSlots.push_back(front[mostCrowded].slot);
+        front.erase(front.begin() + mostCrowded);
+    }
+};
+
+// Resultado de un torneo por capa: indice del individuo ganador para cada politica
+using LayerSelection = array<int, NUM_POLICIES>;
+
+/*
+ Torneo binario por capa: para cada politica gana el cromosoma de menor nivel
+ de dominancia (o mayor crowding) entre dos individuos al azar
+ 
+ No copia ningun cromosoma: devuelve los indices de los ganadores.
+ 
+ population: Poblacion ordenada (domLevel y crowdingDistance asignados)
+ rng: Generador de numeros aleatorios
+ LayerSelection: Indice del ganador en cada capa
+ */
+LayerSelection tournamentSelection(const Population& population, RandomEngine& rng) {
+    int index1 = rng.nextBelow(population.size());
+    int index2 = rng.nextBelow(population.size());
+    const Individual& A = population[index1];
+    const Individual& B = population[index2];
+    LayerSelection winners;
+    for(int c=0; c<A.getNumChromosomes(); c++){
+        const Chromosome& a = A.chromosomes[c];
+        const Chromosome& b = B.chromosomes[c];
+        if (a.domLevel < b.domLevel){
+            winners[c] = index1;
+        }
+        else if (b.domLevel < a.domLevel){
+            winners[c] = index2;
+        }
+        else {
+            winners[c] = (a.crowdingDistance > b.crowdingDistance) ? index1 : index2;
+        }
+    }
+    return winners;
+}
+
+/*
+ Copia en un individuo los cromosomas ganadores de un torneo por capa
+ 
+ El ganador conserva su fitness y checkpoints: solo se reevalua si sus genes cambian.
+ */
+void copySelection(const Population& population, const LayerSelection& winners, Individual& chosen) {
+    for (int c = 0; c < NUM_POLICIES; c++) {
+        Chromosome& winnerCopy = chosen.chromosomes[c];
+        winnerCopy.copyFrom(population[winners[c]].chromosomes[c]);
+        winnerCopy.domLevel = -1;
+        winnerCopy.crowdingDistance = -1;
+    }
+}
+
+void selectParents(const Population& population, int numParents, vector<LayerSelection>& parents, RandomEngine& rng) {
+    parents.resize(numParents);
+    
+    for (int i = 0; i < numParents; i++) {
+        parents[i] = tournamentSelection(population, rng);
+    }
+}
+
+/*
+ Mezcla dos cromosomas gen a gen segun una mascara de bits
+ 
+ El hijo 1 toma el gen i del padre 1 si el bit i de la mascara vale 1 (y del
+ padre 2 si vale 0); el hijo 2 recibe el gen complementario. Con genes de 8
+ bits se procesan 64 genes por instruccion (AVX-512BW) o 32 (AVX2). Los
+ bloques se recorren completos: los cromosomas estan rellenados hasta 64
+ bytes y los genes del relleno no se usan.
+ 
+ parent1, parent2: Genes de los padres
+ offspring1, offspring2: Genes de los hijos
+ mask: Mascara de (numGenes + 63) / 64 palabras
+ numGenes: Numero de genes
+ */
+void blendGenes(const Gene* parent1, const Gene* parent2, Gene* offspring1, Gene* offspring2, const uint64_t* mask, int numGenes) {
+#if defined(__AVX512BW__)
+    if (sizeof(Gene) == 1) {
+        for (int i = 0; i < numGenes; i += 64) {
+            __mmask64 takeFirst = mask[i / 64];
+            __m512i a = _mm512_loadu_si512(parent1 + i);
+            __m512i b = _mm512_loadu_si512(parent2 + i);
+            _mm512_storeu_si512(offspring1 + i, _mm512_mask_blend_epi8(takeFirst, b, a));
+            _mm512_storeu_si512(offspring2 + i, _mm512_mask_blend_epi8(takeFirst, a, b));
+        }
+        return;
+    }
+#elif defined(__AVX2__)
+    if (sizeof(Gene) == 1) {
+        // Expande 32 bits de la mascara a 32 bytes (0x00 o 0xFF)
+        const __m256i byteOfBit = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+                                                   2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+        const __m256i bitOfByte = _mm256_set1_epi64x(0x8040201008040201LL);
+        for (int i = 0; i < numGenes; i += 32) {
+            uint32_t bits = uint32_t(mask[i / 64] >> (i % 64));
+            __m256i spread = _mm256_shuffle_epi8(_mm256_set1_epi32(int(bits)), byteOfBit);
+            __m256i takeFirst = _mm256_cmpeq_epi8(_mm256_and_si256(spread, bitOfByte), bitOfByte);
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(parent1 + i));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(parent2 + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(offspring1 + i), _mm256_blendv_epi8(b, a, takeFirst));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(offspring2 + i), _mm256_blendv_epi8(a, b, takeFirst));
+        }
+        return;
+    }
+#endif
+    for (int i = 0; i < numGenes; i++) {
+        bool takeFirst = (mask[i / 64] >> (i % 64)) & 1;
+        offspring1[i] = takeFirst ? parent1[i] : parent2[i];
+        offspring2[i] = takeFirst ? parent2[i] : parent1[i];
+    }
+}
+
+/*
+ Cruza dos padres (seleccionados por capa) y escribe los dos hijos
+ 
+ La decision de cada gen (de que padre lo toma cada hijo) es la misma en las
+ 6 capas y se genera en bloque como una mascara de bits aleatorios.
+ Los hijos pueden ser individuos de la misma poblacion que los padres,
+ siempre que no sean ninguno de los seleccionados.
+ 
+ mask: Buffer de trabajo para la mascara (se redimensiona si hace falta)
+ */
+void uniformCrossover(const Population& population, const LayerSelection& parent1, const LayerSelection& parent2, Individual& offspring1, Individual& offspring2, RandomEngine& rng, float crossoverRate, vector<uint64_t>& mask) {
+    if (rng.nextDouble() < crossoverRate){
+        const int numGenes = population.getNumGenes();
+        mask.resize((numGenes + 63) / 64);
+        for (auto& word : mask) {
+            word = rng();
+        }
+        for(int j = 0; j < NUM_POLICIES; j++){
+            blendGenes(population[parent1[j]].chromosomes[j].genes, population[parent2[j]].chromosomes[j].genes,
+                       offspring1.chromosomes[j].genes, offspring2.chromosomes[j].genes, mask.data(), numGenes);
+            offspring1.chromosomes[j].reset();
+            offspring2.chromosomes[j].reset();
+        }
+    } else {
+        copySelection(population, parent1, offspring1);
+        copySelection(population, parent2, offspring2);
+    }
+}
+
+/*
+ Genera la descendencia de los padres seleccionados dentro de la misma poblacion
+ 
+ Los hijos se escriben a partir de la posicion firstOffspring, que debe quedar
+ despues de todos los padres.
+ */
+void uniformCrossoverPopulation(Population& population, const vector<LayerSelection>& parents, size_t firstOffspring, RandomEngine& rng, float crossoverRate) {
+    vector<uint64_t> mask;
+    for (size_t i = 0; i < parents.size(); i += 2) {
+        const LayerSelection& parent1 = parents[i];
+        const LayerSelection& parent2 = parents[(i + 1) % parents.size()];
+        
+        uniformCrossover(population, parent1, parent2, population[firstOffspring + i], population[firstOffspring + i + 1], rng, crossoverRate, mask);
+    }
+}
+
+// Forma de elegir los sobrevivientes entre padres e hijos
+enum class SurvivorSelection {
+    Tournament, // Torneos binarios con reemplazo
+    Truncation  // Truncamiento elitista (mu + lambda) de NSGA-II
+};
+
+/*
+ Elige por capa los sobrevivientes de una poblacion combinada, sin copiarlos
+ 
+ Con Tournament cada sobreviviente gana un torneo binario por capa. Con
+ Truncation cada capa se llena frente por frente y el ultimo frente que no
+ cabe completo se corta por crowding (nth_element, sin ordenarlo entero);
+ no usa el generador.
+ 
+ combinedPopulation: Poblacion ordenada (domLevel y crowdingDistance asignados)
+ desiredSize: Numero de sobrevivientes
+ survivors: Salida, ganadores por capa de cada sobreviviente
+ */
+void selectSurvivorIndices(const Population& combinedPopulation, int desiredSize, vector<LayerSelection>& survivors, SurvivorSelection mode, RandomEngine& rng) {
+    survivors.resize(desiredSize);
+    if (mode == SurvivorSelection::Tournament) {
+        for (int i = 0; i < desiredSize; i++) {
+            survivors[i] = tournamentSelection(combinedPopulation, rng);
+        }
+        return;
+    }
+    
+    vector<int> order(combinedPopulation.size());
+    for (int c = 0; c < NUM_POLICIES; c++) {
+        auto layer = [&combinedPopulation, c](int index) -> const Chromosome& {
+            return combinedPopulation[index].chromosomes[c];
+        };
+        iota(order.begin(), order.end(), 0);
+        
+        // Primer frente que no cabe completo
+        vector<int> frontSizes;
+        for (int index : order) {
+            int level = layer(index).domLevel;
+            if (level > static_cast<int>(frontSizes.size())) frontSizes.resize(level, 0);
+            frontSizes[level - 1]++;
+        }
+        int lastLevel = 1;
+        int taken = 0;
+        while (lastLevel <= static_cast<int>(frontSizes.size()) && taken + frontSizes[lastLevel - 1] <= desiredSize) {
+            taken += frontSizes[lastLevel - 1];
+            lastLevel++;
+        }
+        
+        auto complete = partition(order.begin(), order.end(), [&](int index) { return layer(index).domLevel < lastLevel; });
+        auto lastFront = partition(complete, order.end(), [&](int index) { return layer(index).domLevel == lastLevel; });
+        if (taken < desiredSize) {
+            nth_element(complete, complete + (desiredSize - taken - 1), lastFront, [&](int a, int b) {
+                return layer(a).crowdingDistance > layer(b).crowdingDistance;
+            });
+        }
+        for (int i = 0; i < desiredSize; i++) {
+            survivors[i][c] = order[i];
+        }
+    }
+}
+
+void selectSurvivors(const Population& combinedPopulation, int desiredSize, Population& survivors, RandomEngine& rng, SurvivorSelection mode = SurvivorSelection::Tournament) {
+    vector<LayerSelection> winners;
+    selectSurvivorIndices(combinedPopulation, desiredSize, winners, mode, rng);
+    survivors.resize(desiredSize);
+    for(int i = 0; i<desiredSize; i++){
+        copySelection(combinedPopulation, winners[i], survivors[i]);
+    }
+}
+
+void mutationInterChromosome(Individual& individual, RandomEngine& rng, float mutationRate) {
+    if (rng.nextDouble() < mutationRate){
+        int a = rng.nextBelow(individual.getNumChromosomes());
+        int b;
+        do {
+            b = rng.nextBelow(individual.getNumChromosomes());
+        } while (b == a);
+        Chromosome& first = individual.chromosomes[a];
+        swap_ranges(first.genes, first.genes + first.size(), individual.chromosomes[b].genes);
+        individual.chromosomes[a].markDirty();
+        individual.chromosomes[b].markDirty();
+    }
+}
+
+void mutationReciprocalExchange(Individual& individual, RandomEngine& rng, float mutationRate) {
+    if (rng.nextDouble() < mutationRate){
+        int n = individual.chromosomes[0].size();
+        for (int c = 0; c < individual.getNumChromosomes(); c++){
+            int k = min(rng.nextInt(1, 3), n / 2); // rango [1,3]
+            // 2k posiciones distintas al azar (sin barajar todo el cromosoma)
+            int positions[6];
+            for (int p = 0; p < 2 * k; p++) {
+                bool repeated;
+                do {
+                    positions[p] = rng.nextBelow(n);
+                    repeated = find(positions, positions + p, positions[p]) != positions + p;
+                } while (repeated);
+            }
+
+            Gene* genes = individual.chromosomes[c].genes;
+            for (int pairCount = 0; pairCount < k; pairCount++) {
+                int i = positions[2*pairCount];
+                int j = positions[2*pairCount+1];
+                swap(genes[i], genes[j]);
+                individual.chromosomes[c].markDirty(min(i, j));
+            }
+        }
+    }
+}
+
+void mutationShift(Individual& individual, RandomEngine& rng, float mutationRate){
+    if (rng.nextDouble() < mutationRate){
+        int windowSize = rng.nextInt(3, 5);
+        int n = individual.chromosomes[0].size();
+        if (n < windowSize) return;
+        for (int c = 0; c < individual.getNumChromosomes(); c++){
+            int startIdx = rng.nextInt(0, n - windowSize);
+            // Shift right: el ultimo gen de la ventana pasa al inicio
+            Gene* window = individual.chromosomes[c].genes + startIdx;
+            rotate(window, window + windowSize - 1, window + windowSize);
+            individual.chromosomes[c].markDirty(startIdx);
+        }
+    }
+}
+
+void graphParetoFront(const ParetoArchive& archive) {
+    int numChrom = NUM_POLICIES;
+
+    vector<vector<double>> x_vals(numChrom);
+    vector<vector<double>> y_vals(numChrom);
+
+    // Puntos archivados de cada cromosoma
+    for (int c = 0; c < numChrom; c++) {
+        for (size_t k = 0; k < archive.size(c); k++) {
+            x_vals[c].push_back(archive.entry(c, k).chromosomes[c].f1);
+            y_vals[c].push_back(archive.entry(c, k).chromosomes[c].f2);
+        }
+    }
+
+    // Colores predefinidos
+    vector<string> colors = {"r", "g", "b", "m", "c", "y", "k"};
+
+    // Crear una figura
+    figure(true);
+    hold(on);
+
+    for (int c = 0; c < numChrom; c++) {
+        auto sc = scatter(x_vals[c], y_vals[c], 10);
+        sc->color(colors[c % colors.size()]);  // Reutiliza si hay más cromosomas que colores
+        sc->display_name("Cromosoma " + policyNames[c]); // Etiqueta
+    }
+
+    title("Poblacion - Distribucion de Makespan vs Energia");
+    xlabel("Makespan");
+    ylabel("Energia");
+
+    legend(); // <--- Agrega la leyenda automáticamente
+    hold(off);
+    show();
+}
+
+void graphPopulation(const Population& population) {
+    int numChrom = population[0].getNumChromosomes();
+
+    vector<vector<double>> x_vals(numChrom);
+    vector<vector<double>> y_vals(numChrom);
+
+    // Clasificar puntos por cromosoma
+    for (int c = 0; c < numChrom; c++) {
+        for (const Individual& ind : population) {
+            x_vals[c].push_back(ind.chromosomes[c].f1);
+            y_vals[c].push_back(ind.chromosomes[c].f2);
+        }
+    }
+
+    // Colores predefinidos
+    vector<string> colors = {"r", "g", "b", "m", "c", "y", "k"};
+
+    // Crear una figura
+    figure(true);
+    hold(on);
+
+    for (int c = 0; c < numChrom; c++) {
+        auto sc = scatter(x_vals[c], y_vals[c], 10);
+        sc->color(colors[c % colors.size()]);  // Reutiliza si hay más cromosomas que colores
+        sc->display_name("Cromosoma " + population[0].chromosomes[c].getPolicyName()); // Etiqueta
+    }
+
+    title("Poblacion - Distribucion de Makespan vs Energia");
+    xlabel("Makespan");
+    ylabel("Energia");
+
+    legend(); // <--- Agrega la leyenda automáticamente
+    hold(off);
+    show();
+}
+
+/*
+ Aplica los tres operadores de mutacion a un individuo, con las tasas del algoritmo
+ */
+void mutateIndividual(Individual& individual, RandomEngine& rng) {
+    mutationInterChromosome(individual, rng, 0.3);
+    mutationReciprocalExchange(individual, rng, 0.2);
+    mutationShift(individual, rng, 0.1);
+}
+
+/*
+ Calcula la capacidad que necesita una poblacion para alojar tambien su descendencia
+ */
+int generationCapacity(int populationSize) {
+    return populationSize + (populationSize + 1) / 2 * 2;
+}
+
+/*
+ Ejecuta una generacion del algoritmo genetico
+ 
+ La descendencia se escribe despues de la poblacion actual, dentro de su
+ misma arena, y los sobrevivientes se copian a nextPopulation; al final
+ ambas poblaciones se intercambian. Ninguna de las dos reserva memoria.
+ 
+ population: Poblacion actual, evaluada y ordenada (capacidad generationCapacity)
+ nextPopulation: Poblacion auxiliar (capacidad generationCapacity)
+ archive: Archivo de Pareto que recibe cada individuo recien evaluado (opcional)
+ survivorSelection: Torneos (por defecto) o truncamiento elitista
+ firstFronts: Primer frente de cada capa de la nueva poblacion (opcional, ver fastNonDominatedSort)
+ 
+ Con truncamiento la generacion es (mu + lambda): solo se mutan los hijos,
+ antes de evaluarlos, y los padres quedan intactos. Asi el truncamiento
+ compara el fitness real de todos y ningun padre del primer frente se
+ pierde frente a un hijo que en realidad es peor.
+ */
+void geneticAlgorithmStep(Population& population, Population& nextPopulation, int populationSize, RandomEngine& rng, PopulationEvaluator& evaluator, ThreadPool& pool, ParetoArchive* archive = nullptr, SurvivorSelection survivorSelection = SurvivorSelection::Tournament, vector<vector<int>>* firstFronts = nullptr) {
+    vector<LayerSelection> parents;
+    selectParents(population, populationSize, parents, rng);
+    size_t firstOffspring = population.size();
+    population.resize(firstOffspring + (parents.size() + 1) / 2 * 2);
+    uniformCrossoverPopulation(population, parents, firstOffspring, rng, 0.8);
+    
+    const bool elitist = survivorSelection == SurvivorSelection::Truncation;
+    if (elitist) {
+        for (size_t i = firstOffspring; i < population.size(); i++) {
+            mutateIndividual(population[i], rng);
+        }
+    }
+    
+    // Solo la descendencia esta pendiente de evaluar; sin truncamiento se archiva antes de mutar
+    evaluator.evaluate(population);
+    if (archive != nullptr) archive->update(population);
+    
+    for (int i=0; i<population.size(); i++){
+        if (!elitist) mutateIndividual(population[i], rng);
+        for (int j=0; j<population[i].chromosomes.size(); j++){
+            population[i].chromosomes[j].domLevel = -1;
+            population[i].chromosomes[j].crowdingDistance = -1;
+        }
+    }
+    fastNonDominatedSort(population, &pool);
+    selectSurvivors(population, populationSize, nextPopulation, rng, survivorSelection);
+    swap(population, nextPopulation);
+    evaluator.evaluate(population);
+    if (archive != nullptr) archive->update(population);
+    fastNonDominatedSort(population, &pool, firstFronts);
+}
+
+// MODO ESTACIONARIO ASINCRONO
+
+/*
+ WorkQueue
+ Cola acotada de indices sin bloqueos, para varios productores y varios consumidores
+ 
+ Cada celda lleva un numero de secuencia que dice si esta libre para el
+ productor de la vuelta actual o lista para su consumidor. Productores y
+ consumidores solo compiten por su propio contador (compare_exchange), sin
+ mutex, y ninguna operacion espera: push y pop devuelven false si la cola
+ esta llena o vacia.
+ 
+ capacity: Numero maximo de elementos (se redondea a una potencia de 2)
+ */
+class WorkQueue {
+public:
+    explicit WorkQueue(size_t capacity) : enqueuePos(0), dequeuePos(0) {
+        size_t size = 2;
+        while (size < capacity) size *= 2;
+        cells.reset(new Cell[size]);
+        mask = size - 1;
+        for (size_t i = 0; i < size; i++) {
+            cells[i].sequence.store(i, memory_order_relaxed);
+        }
+    }
+    
+    WorkQueue(const WorkQueue&) = delete;
+    WorkQueue& operator=(const WorkQueue&) = delete;
+    
+    bool push(int value) {
+        size_t pos = enqueuePos.load(memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells[pos & mask];
+            size_t sequence = cell->sequence.load(memory_order_acquire);
+            intptr_t difference = intptr_t(sequence) - intptr_t(pos);
+            if (difference == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) break;
+            } else if (difference < 0) {
+                return false;
+            } else {
+                pos = enqueuePos.load(memory_order_relaxed);
+            }
+        }
+        cell->value = value;
+        cell->sequence.store(pos + 1, memory_order_release);
+        return true;
+    }
+    
+    bool pop(int& value) {
+        size_t pos = dequeuePos.load(memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells[pos & mask];
+            size_t sequence = cell->sequence.load(memory_order_acquire);
+            intptr_t difference = intptr_t(sequence) - intptr_t(pos + 1);
+            if (difference == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) break;
+            } else if (difference < 0) {
+                return false;
+            } else {
+                pos = dequeuePos.load(memory_order_relaxed);
+            }
+        }
+        value = cell->value;
+        cell->sequence.store(pos + mask + 1, memory_order_release);
+        return true;
+    }
+    
+private:
+    struct Cell {
+        atomic<size_t> sequence;
+        int value;
+    };
+    
+    unique_ptr<Cell[]> cells;
+    size_t mask;
+    alignas(64) atomic<size_t> enqueuePos;
+    alignas(64) atomic<size_t> dequeuePos;
+};
+
+/*
+ WakeSignal
+ Aviso para hilos que duermen mientras una cola sin bloqueos esta vacia
+ 
+ Quien consume prueba primero la cola sin tomar ningun mutex y solo llama a
+ wait si la encontro vacia: ahi se anota como dormido y vuelve a probar con
+ el mutex tomado antes de dormir. Quien publica llama a notify despues de
+ publicar, y solo toma el mutex si hay alguien anotado. Las barreras seq_cst
+ entre anotarse y volver a probar, y entre publicar y leer el contador,
+ garantizan que o el que publica ve al dormido, o el dormido ve lo publicado.
+ */
+class WakeSignal {
+public:
+    WakeSignal() : sleepers(0) {}
+    
+    WakeSignal(const WakeSignal&) = delete;
+    WakeSignal& operator=(const WakeSignal&) = delete;
+    
+    /*
+     Duerme hasta que ready devuelva true
+     
+     ready: Condicion de salida; se evalua con el mutex tomado y puede consumir de la cola
+     */
+    template <typename Predicate>
+    void wait(Predicate ready) {
+        unique_lock<mutex> lock(wakeMutex);
+        sleepers.fetch_add(1);
+        atomic_thread_fence(memory_order_seq_cst);
+        condition.wait(lock, ready);
+        sleepers.fetch_sub(1);
+    }
+    
+    // Despierta a uno (o a todos) de los que duermen, si hay alguno
+    void notify(bool all = false) {
+        atomic_thread_fence(memory_order_seq_cst);
+        if (sleepers.load() == 0) return;
+        {
+            lock_guard<mutex> lock(wakeMutex);
+        }
+        if (all) condition.notify_all();
+        else condition.notify_one();
+    }
+    
+private:
+    mutex wakeMutex;
+    condition_variable condition;
+    atomic<int> sleepers;
+};
+
+/*
+ HypervolumeTracker
+ Hipervolumen de un frente de dos objetivos, actualizado en cada insercion o eliminacion
+ 
+ Con los puntos ordenados por f1, el hipervolumen es la suma de una franja
+ por punto: ancho (refF1 - f1) por el alto entre su f2 y el de su vecino
+ anterior (o refF2), recortados a la caja de referencia. La franja de un
+ punto solo depende de su vecino anterior, asi que agregar o quitar un
+ punto cambia dos franjas: O(log n) por operacion. Da el mismo valor que
+ calculateHyperVolume sobre el mismo frente (salvo redondeo).
+ 
+ refF1, refF2: Punto de referencia
+ */
+class HypervolumeTracker {
+public:
+    HypervolumeTracker(double refF1, double refF2) : refF1(refF1), refF2(refF2), volume(0.0) {}
+    
+    void add(double f1, double f2) {
+        auto next = points.upper_bound({f1, f2});
+        if (next != points.end()) volume -= strip(next);
+        auto position = points.insert(next, {f1, f2});
+        volume += strip(position);
+        if (next != points.end()) volume += strip(next);
+    }
+    
+    void remove(double f1, double f2) {
+        auto position = points.find({f1, f2});
+        if (position == points.end()) return;
+        auto next = std::next(position);
+        if (next != points.end()) volume -= strip(next);
+        volume -= strip(position);
+        next = points.erase(position);
+        if (next != points.end()) volume += strip(next);
+    }
+    
+    double hypervolume() const {
+        return volume;
+    }
+    
+private:
+    double refF1;
+    double refF2;
+    double volume;
+    multiset<pair<double, double>> points;
+    
+    double strip(multiset<pair<double, double>>::const_iterator point) const {
+        double width = refF1 - point->first;
+        double top = (point == points.begin()) ? refF2 : min(refF2, prev(point)->second);
+        double height = top - point->second;
+        return (width > 0 && height > 0) ? width * height : 0.0;
+    }
+};
+
+// Criterio con el que el modo estacionario elige que cromosoma sale de cada capa
+enum class SteadyStateReplacement {
+    Crowding,   // Menor crowding del ultimo frente
+    Hypervolume // Menor contribucion exclusiva al hipervolumen del ultimo frente (SMS-EMOA)
+};
+
+/*
+ ContributionFronts
+ Frentes de una capa mantenidos en forma incremental, con el puntaje de cada
+ punto dentro de su frente: su crowding o su contribucion exclusiva al
+ hipervolumen (seleccion estilo SMS-EMOA)
+ 
+ Cada frente es un arbol ordenado por (f1, f2), con f2 decreciente, mas un
+ conjunto ordenado por puntaje. En dos objetivos la contribucion exclusiva
+ de un punto interior es el rectangulo entre sus vecinos,
+ (f1[i+1] - f1[i]) * (f2[i-1] - f2[i]), y el crowding es la suma de las
+ distancias entre sus vecinos normalizadas por el rango del frente; los
+ extremos valen infinito. Al insertar o quitar un punto solo cambian sus
+ vecinos, asi que:
+ - el nivel de un punto nuevo sale de una busqueda binaria sobre los
+   frentes, y cada prueba es una busqueda en el arbol de un frente;
+ - los puntos que domina forman un tramo contiguo que baja al frente
+   siguiente; ahi cada punto que llega desplaza solo a los que domina,
+   que estan justo despues de el, y el descenso sigue mientras haya
+   desplazados;
+ - solo se recalcula el puntaje de los puntos movidos y de sus vecinos.
+ Cada paso cuesta O(log n) por punto que cambia de frente. Con crowding,
+ cuando cambia el rango de un frente (entra o sale un extremo) se recalcula
+ ese frente completo.
+ 
+ Entre puntos con el mismo (f1, f2) manda el orden de llegada al frente
+ (sello), y ninguno domina al otro.
+ 
+ El puntaje queda en crowdingDistance de cada cromosoma y domLevel se
+ mantiene al dia, de modo que los torneos (tournamentSelection) lo usan.
+ Opcionalmente avisa a un HypervolumeTracker de cada punto que entra o
+ sale del primer frente.
+ 
+ population: Poblacion a la que pertenecen los indices
+ c: Capa (politica)
+ score: Puntaje de cada punto (crowding o contribucion al hipervolumen)
+ */
+class ContributionFronts {
+public:
+    ContributionFronts(Population& population, int c, SteadyStateReplacement score = SteadyStateReplacement::Hypervolume)
+        : population(population), c(c), score(score), tracker(nullptr), nextStamp(0) {}
+    
+    // Empieza a informar a un tracker los cambios del primer frente (se le agregan los puntos actuales)
+    void track(HypervolumeTracker* frontTracker) {
+        tracker = frontTracker;
+        if (tracker == nullptr || fronts.empty()) return;
+        for (const Member& member : fronts[0].members) {
+            tracker->add(member.f1, member.f2);
+        }
+    }
+    
+    // Inserta el cromosoma de la capa de un individuo ya evaluado
+    void insert(int index) {
+        int level = levelFor(index);
+        if (level == static_cast<int>(fronts.size())) {
+            fronts.emplace_back();
+        }
+        Front& front = fronts[level];
+        auto inserted = add(front, level, index);
+        
+        // Los puntos que domina el nuevo son los siguientes en el orden, en un tramo contiguo
+        vector<int> dominated;
+        auto next = std::next(inserted);
+        while (next != front.members.end() && dominates(index, next->index)) {
+            dominated.push_back(next->index);
+            next = take(front, level, next);
+        }
+        if (!rescaled(front)) {
+            updateAround(front, inserted);
+        }
+        if (!dominated.empty()) {
+            descend(level + 1, dominated);
+        }
+    }
+    
+    // Individuo de menor puntaje del ultimo frente
+    int worst() const {
+        return fronts.back().byContribution.begin()->second;
+    }
+    
+    // Quita un punto del ultimo frente (no cambia el nivel de ningun otro)
+    void remove(int index) {
+        Front& front = fronts.back();
+        auto next = take(front, fronts.size() - 1, front.members.find(key(index)));
+        if (front.members.empty()) {
+            fronts.pop_back();
+            return;
+        }
+        if (rescaled(front)) return;
+        if (next != front.members.end()) {
+            updateScore(front, next);
+        }
+        if (next != front.members.begin()) {
+            updateScore(front, prev(next));
+        }
+    }
+    
+    /*
+     Cambia el indice de un punto (despues de copiar su cromosoma a otra posicion)
+     El cromosoma de la posicion to ya debe tener el fitness, nivel y puntaje del de from.
+     */
+    void relabel(int from, int to) {
+        Front& front = fronts[layer(to).domLevel - 1];
+        stampOf(to) = stampOf(from);
+        front.members.find(key(to))->index = to;
+        front.byContribution.erase({layer(to).crowdingDistance, from});
+        front.byContribution.insert({layer(to).crowdingDistance, to});
+    }
+    
+private:
+    // Punto de un frente; el orden del arbol es (f1, f2, sello)
+    struct Member {
+        double f1;
+        double f2;
+        long stamp;
+        mutable int index; // No participa del orden
+        
+        bool operator<(const Member& other) const {
+            if (f1 != other.f1) return f1 < other.f1;
+            if (f2 != other.f2) return f2 < other.f2;
+            return stamp < other.stamp;
+        }
+    };
+    
+    struct Front {
+        set<Member> members;
+        set<pair<double, int>> byContribution; // (puntaje, indice)
+        double f1Range = -1; // Rango con el que se calculo el crowding
+        double f2Range = -1;
+    };
+    
+    Population& population;
+    int c;
+    SteadyStateReplacement score;
+    vector<Front> fronts;
+    HypervolumeTracker* tracker;
+    vector<long> stamps; // Sello de llegada al frente actual, por indice
+    long nextStamp;
+    
+    Chromosome& layer(int index) const {
+        return population[index].chromosomes[c];
+    }
+    
+    long& stampOf(int index) {
+        if (index >= static_cast<int>(stamps.size())) {
+            stamps.resize(index + 1, 0);
+        }
+        return stamps[index];
+    }
+    
+    Member key(int index) {
+        return Member{layer(index).f1, layer(index).f2, stampOf(index), index};
+    }
+    
+    // Si q (anterior a p en el orden por (f1, f2)) domina a p; mismo criterio que assignDominanceLevels
+    bool dominates(int q, int p) const {
+        const Chromosome& Q = layer(q);
+        const Chromosome& P = layer(p);
+        return Q.f2 < P.f2 || (Q.f2 == P.f2 && Q.f1 < P.f1);
+    }
+    
+    // Si algun miembro de un frente domina al punto: basta el ultimo con (f1, f2) no mayor
+    bool dominatedBy(const Front& front, int index) const {
+        const Chromosome& point = layer(index);
+        auto position = front.members.lower_bound(Member{point.f1, point.f2, numeric_limits<long>::max(), index});
+        return position != front.members.begin() && dominates(prev(position)->index, index);
+    }
+    
+    // Primer frente que no domina al punto (si uno lo domina, tambien los anteriores)
+    int levelFor(int index) const {
+        int low = 0;
+        int high = fronts.size();
+        while (low < high) {
+            int mid = (low + high) / 2;
+            if (dominatedBy(fronts[mid], index)) low = mid + 1;
+            else high = mid;
+        }
+        return low;
+    }
+    
+    // Agrega un punto a un frente, despues de los que tengan su mismo (f1, f2)
+    set<Member>::iterator add(Front& front, int level, int index) {
+        stampOf(index) = nextStamp++;
+        layer(index).domLevel = level + 1;
+        if (level == 0 && tracker != nullptr) {
+            tracker->add(layer(index).f1, layer(index).f2);
+        }
+        return front.members.insert(key(index)).first;
+    }
+    
+    // Saca un punto de un frente; devuelve el siguiente
+    set<Member>::iterator take(Front& front, int level, set<Member>::iterator member) {
+        front.byContribution.erase({layer(member->index).crowdingDistance, member->index});
+        if (level == 0 && tracker != nullptr) {
+            tracker->remove(member->f1, member->f2);
+        }
+        return front.members.erase(member);
+    }
+    
+    void updateScore(Front& front, set<Member>::iterator member) {
+        Chromosome& point = layer(member->index);
+        front.byContribution.erase({point.crowdingDistance, member->index});
+        auto next = std::next(member);
+        if (member == front.members.begin() || next == front.members.end()) {
+            point.crowdingDistance = numeric_limits<double>::infinity();
+        } else if (score == SteadyStateReplacement::Hypervolume) {
+            point.crowdingDistance = (next->f1 - point.f1) * (prev(member)->f2 - point.f2);
+        } else {
+            point.crowdingDistance = 0;
+            if (front.f1Range > 0) point.crowdingDistance += (next->f1 - prev(member)->f1) / front.f1Range;
+            if (front.f2Range > 0) point.crowdingDistance += (prev(member)->f2 - next->f2) / front.f2Range;
+        }
+        front.byContribution.insert({point.crowdingDistance, member->index});
+    }
+    
+    // Con crowding, si cambio el rango del frente recalcula todos sus puntajes (devuelve true)
+    bool rescaled(Front& front) {
+        if (score != SteadyStateReplacement::Crowding) return false;
+        double f1Range = prev(front.members.end())->f1 - front.members.begin()->f1;
+        double f2Range = front.members.begin()->f2 - prev(front.members.end())->f2;
+        if (f1Range == front.f1Range && f2Range == front.f2Range) return false;
+        front.f1Range = f1Range;
+        front.f2Range = f2Range;
+        for (auto member = front.members.begin(); member != front.members.end(); ++member) {
+            updateScore(front, member);
+        }
+        return true;
+    }
+    
+    // Recalcula el puntaje de un punto y de sus dos vecinos
+    void updateAround(Front& front, set<Member>::iterator member) {
+        if (member != front.members.begin()) {
+            updateScore(front, prev(member));
+        }
+        updateScore(front, member);
+        if (std::next(member) != front.members.end()) {
+            updateScore(front, std::next(member));
+        }
+    }
+    
+    /*
+     Baja puntos desplazados a un frente y propaga hacia abajo los que queden dominados
+     
+     Ningun punto que llega esta dominado por el frente que lo recibe (si lo
+     estuviera, ya habria estado mas abajo). Los miembros que domina un punto
+     que llega son los que le siguen en el orden hasta el primero que no
+     domina, asi que cada paso visita solo a desplazados.
+     
+     level: Frente que recibe los puntos
+     incoming: Puntos desplazados, ordenados por (f1, f2)
+     */
+    void descend(int level, vector<int> incoming) {
+        vector<int> displaced;
+        while (!incoming.empty()) {
+            if (level == static_cast<int>(fronts.size())) {
+                fronts.emplace_back();
+            }
+            Front& front = fronts[level];
+            displaced.clear();
+            for (int arriving : incoming) {
+                const Chromosome& point = layer(arriving);
+                auto member = front.members.lower_bound(Member{point.f1, point.f2, numeric_limits<long>::max(), arriving});
+                while (member != front.members.end() && dominates(arriving, member->index)) {
+                    displaced.push_back(member->index);
+                    member = take(front, level, member);
+                }
+            }
+            // Los vecinos de cada tramo desplazado quedan junto a un punto que llega
+            for (int arriving : incoming) {
+                add(front, level, arriving);
+            }
+            if (!rescaled(front)) {
+                for (int arriving : incoming) {
+                    updateAround(front, front.members.find(key(arriving)));
+                }
+            }
+            incoming.swap(displaced);
+            level++;
+        }
+    }
+};
+
+/*
+ SteadyStateEngine
+ Algoritmo estacionario asincrono: un coordinador y varios trabajadores sin barrera por generacion
+ 
+ El hilo que llama a run es el coordinador. Mantiene llena la cola de
+ candidatos: cruza y muta hijos en los espacios libres de una arena propia.
+ Los trabajadores toman candidatos de esa cola, los evaluan y los devuelven
+ por una segunda cola. El coordinador inserta cada hijo terminado en la
+ poblacion y, mientras no hay resultados, tambien evalua candidatos. Las
+ colas se consumen sin mutex; solo quien las encuentra vacias duerme en un
+ WakeSignal hasta que llega un candidato (trabajadores) o un resultado
+ (coordinador).
+ 
+ La insercion es (mu + 1) por capa. Los frentes de cada capa se mantienen
+ con ContributionFronts, asi que cada insercion toca solo los vecinos del
+ punto nuevo y los tramos que bajan de frente. Sale el peor del ultimo
+ frente, que puede ser el mismo hijo: el de menor crowding o, con
+ SteadyStateReplacement::Hypervolume, el de menor contribucion exclusiva al
+ hipervolumen. Quitar un cromosoma del ultimo frente no cambia el nivel de
+ ningun otro.
+ 
+ Los hijos se insertan en el orden en que terminan. Por eso, con mas de un
+ hilo, la corrida no se repite exactamente con la misma semilla; con un
+ solo hilo si.
+ 
+ data: Datos del escenario
+ population: Poblacion evaluada (capacidad de al menos size() + 1); se modifica en run
+ rng: Generador de numeros aleatorios (solo lo usa el coordinador)
+ numThreads: Hilos en total (el coordinador y numThreads - 1 trabajadores)
+ cache: Cache de fitness (opcional, nullptr para simular siempre)
+ checkpointInterval: Genes entre checkpoints de simulacion (0 para no usarlos)
+ archive: Archivo de Pareto que recibe cada hijo evaluado (opcional)
+ replacement: Criterio para elegir el cromosoma que sale
+ */
+class SteadyStateEngine {
+public:
+    SteadyStateEngine(const ScenarioData& data, Population& population, RandomEngine& rng, int numThreads,
+                      FitnessCache* cache, int checkpointInterval, ParetoArchive* archive = nullptr,
+                      SteadyStateReplacement replacement = SteadyStateReplacement::Crowding)
+        : data(data), population(population), rng(rng), numThreads(max(1, numThreads)), cache(cache),
+          checkpointInterval(checkpointInterval), archive(archive), replacement(replacement),
+          candidates(4 * this->numThreads, population.getNumGenes()),
+          pending(candidates.size()), finished(candidates.size()), evaluations(0), stopping(false), failed(false) {
+        if (population.capacity() <= population.size()) {
+            throw runtime_error("ERROR: La poblacion del modo estacionario necesita capacidad para un hijo mas");
+        }
+        scratch.resize(this->numThreads);
+        for (auto& workerScratch : scratch) {
+            workerScratch.prepare(data.numMachines, data.numJobs);
+        }
+        for (int c = 0; c < NUM_POLICIES; c++) {
+            contributionFronts.emplace_back(population, c, replacement);
+            for (size_t i = 0; i < population.size(); i++) {
+                contributionFronts[c].insert(i);
+            }
+        }
+    }
+    
+    /*
+     Empieza a seguir el hipervolumen del primer frente de cada capa
+     
+     refF1, refF2: Punto de referencia
+     */
+    void trackHypervolume(double refF1, double refF2) {
+        trackers.clear();
+        for (int c = 0; c < NUM_POLICIES; c++) {
+            trackers.emplace_back(new HypervolumeTracker(refF1, refF2));
+            contributionFronts[c].track(trackers.back().get());
+        }
+    }
+    
+    // Hipervolumen actual del primer frente de una capa (despues de trackHypervolume)
+    double hypervolume(int c) const {
+        return trackers[c]->hypervolume();
+    }
+    
+    /*
+     Produce e inserta populationSize hijos por generacion
+     
+     numGenerations: Generaciones equivalentes (numGenerations * populationSize hijos)
+     onGeneration: Se llama con el numero de generacion cada populationSize inserciones;
+                   si devuelve false la corrida termina ahi
+     keepRunning: Se consulta despues de las demas inserciones (opcional); si devuelve
+                  false la corrida termina ahi, en medio de la generacion
+     long: Hijos insertados
+     */
+    long run(int numGenerations, const function<bool(int)>& onGeneration, const function<bool()>& keepRunning = nullptr) {
+        const int populationSize = population.size();
+        const long target = long(numGenerations) * populationSize;
+        long produced = 0;
+        long inserted = 0;
+        freeSlots.resize(candidates.size());
+        iota(freeSlots.begin(), freeSlots.end(), 0);
+        
+        stopping.store(false);
+        for (int w = 1; w < numThreads; w++) {
+            workers.emplace_back([this, w]() { workerLoop(w); });
+        }
+        try {
+            while (inserted < target) {
+                if (failed.load(memory_order_acquire)) {
+                    rethrow_exception(firstError);
+                }
+                while (freeSlots.size() >= 2 && produced < target) {
+                    produceOffspring();
+                    produced += 2;
+                }
+                int slot = -1;
+                if (!finished.pop(slot)) {
+                    if (pending.pop(slot)) {
+                        evaluate(slot, 0);
+                    } else if (!waitForResult(slot)) {
+                        continue;
+                    }
+                }
+                if (archive != nullptr) archive->offer(candidates[slot]);
+                insert(candidates[slot]);
+                freeSlots.push_back(slot);
+                if (++inserted % populationSize == 0) {
+                    if (!onGeneration(inserted / populationSize)) break;
+                } else if (keepRunning && !keepRunning()) {
+                    break;
+                }
+            }
+        } catch (...) {
+            stopWorkers();
+            throw;
+        }
+        stopWorkers();
+        // Los candidatos que quedaron en las colas se descartan
+        int slot;
+        while (pending.pop(slot) || finished.pop(slot)) {}
+        return inserted;
+    }
+    
+    // Hijos evaluados desde que se creo el motor (incluye los descartados al terminar)
+    long getEvaluations() const {
+        return evaluations.load(memory_order_relaxed);
+    }
+    
+private:
+    const ScenarioData& data;
+    Population& population;
+    RandomEngine& rng;
+    int numThreads;
+    FitnessCache* cache;
+    int checkpointInterval;
+    ParetoArchive* archive;
+    SteadyStateReplacement replacement;
+    Population candidates; // Arena de los hijos en vuelo
+    vector<int> freeSlots; // Espacios de candidates sin usar (solo el coordinador)
+    WorkQueue pending; // Candidatos por evaluar
+    WorkQueue finished; // Candidatos evaluados, por insertar
+    atomic<long> evaluations;
+    vector<EvaluationScratch> scratch;
+    vector<thread> workers;
+    atomic<bool> stopping;
+    atomic<bool> failed;
+    mutex errorMutex;
+    exception_ptr firstError;
+    WakeSignal candidateReady; // Trabajadores esperando candidatos
+    WakeSignal resultReady; // Coordinador esperando resultados
+    vector<uint64_t> mask;
+    vector<ContributionFronts> contributionFronts; // Frentes de cada capa
+    vector<unique_ptr<HypervolumeTracker>> trackers; // Hipervolumen del primer frente de cada capa
+    
+    Chromosome& layer(int c, int index) {
+        return population[index].chromosomes[c];
+    }
+    
+    // Espera un candidato evaluado por un trabajador; false si alguno fallo
+    bool waitForResult(int& slot) {
+        resultReady.wait([&]() { return failed.load(memory_order_acquire) || finished.pop(slot); });
+        return !failed.load(memory_order_acquire);
+    }
+    
+    // Evalua un candidato (desde un trabajador o desde el coordinador)
+    void evaluate(int slot, int workerId) {
+        if (candidates[slot].isDirty()) {
+            evaluations.fetch_add(1, memory_order_relaxed);
+        }
+        evaluateIndividual(candidates[slot], data, scratch[workerId], cache, checkpointInterval);
+    }
+    
+    void workerLoop(int workerId) {
+        while (true) {
+            int slot = -1;
+            if (!pending.pop(slot)) {
+                candidateReady.wait([&]() { return stopping.load(memory_order_acquire) || pending.pop(slot); });
+            }
+            if (stopping.load(memory_order_acquire)) return;
+            try {
+                evaluate(slot, workerId);
+            } catch (...) {
+                {
+                    lock_guard<mutex> lock(errorMutex);
+                    if (!firstError) firstError = current_exception();
+                    failed.store(true, memory_order_release);
+                }
+                resultReady.notify();
+                return;
+            }
+            finished.push(slot);
+            resultReady.notify();
+        }
+    }
+    
+    void stopWorkers() {
+        stopping.store(true, memory_order_release);
+        candidateReady.notify(true);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        workers.clear();
+    }
+    
+    // Cruza dos padres por torneo y muta los dos hijos en espacios libres
+    void produceOffspring() {
+        int first = freeSlots.back();
+        freeSlots.pop_back();
+        int second = freeSlots.back();
+        freeSlots.pop_back();
+        LayerSelection parent1 = tournamentSelection(population, rng);
+        LayerSelection parent2 = tournamentSelection(population, rng);
+        uniformCrossover(population, parent1, parent2, candidates[first], candidates[second], rng, 0.8, mask);
+        for (int slot : {first, second}) {
+            mutateIndividual(candidates[slot], rng);
+            pending.push(slot);
+            candidateReady.notify();
+        }
+    }
+    
+    // Inserta un hijo evaluado en cada capa de la poblacion
+    void insert(const Individual& child) {
+        const int candidate = population.size();
+        population.resize(candidate + 1);
+        population[candidate].copyFrom(child);
+        for (int c = 0; c < NUM_POLICIES; c++) {
+            replaceWorst(c, candidate);
+        }
+        population.resize(candidate);
+    }
+    
+    /*
+     Inserta el cromosoma de la posicion candidate en una capa y saca el peor
+     
+     Al terminar, la capa vuelve a tener candidate cromosomas (posiciones [0, candidate)).
+     */
+    void replaceWorst(int c, int candidate) {
+        ContributionFronts& fronts = contributionFronts[c];
+        fronts.insert(candidate);
+        int worst = fronts.worst();
+        fronts.remove(worst);
+        if (worst != candidate) {
+            layer(c, worst).copyFrom(layer(c, candidate));
+            fronts.relabel(candidate, worst);
+        }
+    }
+};
+
+// GENERACIONES EN TUBERIA
+
+/*
+ GenerationPipeline
+ Ejecuta generaciones con la misma semantica que geneticAlgorithmStep, solapando variacion y evaluacion
+ 
+ El hilo que llama a step entrega cada par de hijos a los trabajadores
+ apenas lo cruza, de modo que la evaluacion de un par corre mientras se
+ cruzan los siguientes. Despues muta a los padres, que no esperan ninguna
+ evaluacion, y a cada hijo en cuanto termina de evaluarse. Con los
+ sobrevivientes pasa lo mismo: cada copia que quedo mutada se evalua
+ mientras se siguen copiando las demas. Mientras espera, el coordinador
+ tambien evalua. Los trabajadores sin individuos en la cola duermen hasta
+ que submit entrega otro, y el coordinador sin pendientes duerme hasta que
+ un trabajador termina uno.
+ Con truncamiento solo se mutan los hijos, todos antes de entregarlos, y
+ los padres no se tocan.
+ 
+ El generador se consume en el mismo orden que en geneticAlgorithmStep, asi
+ que con la misma semilla el resultado es identico. La clasificacion por
+ dominancia necesita a toda la poblacion evaluada: sigue siendo una barrera
+ y se reparte por capas en el pool.
+ 
+ data: Datos del escenario
+ populationSize: Tamano de la poblacion
+ pool: Hilos para la clasificacion por dominancia
+ numThreads: Hilos de evaluacion en total (el coordinador y numThreads - 1 trabajadores)
+ cache: Cache de fitness (opcional, nullptr para simular siempre)
+ checkpointInterval: Genes entre checkpoints de simulacion (0 para no usarlos)
+ survivorSelection: Torneos o truncamiento elitista
+ */
+class GenerationPipeline {
+public:
+    GenerationPipeline(const ScenarioData& data, int populationSize, ThreadPool& pool, int numThreads,
+                       FitnessCache* cache, int checkpointInterval, SurvivorSelection survivorSelection = SurvivorSelection::Tournament)
+        : data(data), populationSize(populationSize), pool(pool), cache(cache), checkpointInterval(checkpointInterval),
+          survivorSelection(survivorSelection),
+          tasks(generationCapacity(populationSize)), ready(new atomic<bool>[generationCapacity(populationSize)]),
+          target(nullptr), outstanding(0), evaluations(0), phase(0), phaseOpen(false), stopping(false), failed(false) {
+        numThreads = max(1, numThreads);
+        scratch.resize(numThreads);
+        for (auto& workerScratch : scratch) {
+            workerScratch.prepare(data.numMachines, data.numJobs);
+        }
+        for (int w = 1; w < numThreads; w++) {
+            workers.emplace_back([this, w]() { workerLoop(w); });
+        }
+    }
+    
+    ~GenerationPipeline() {
+        {
+            lock_guard<mutex> lock(phaseMutex);
+            stopping.store(true);
+            phaseOpen.store(false);
+        }
+        phaseStarted.notify_all();
+        taskReady.notify(true);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+    
+    GenerationPipeline(const GenerationPipeline&) = delete;
+    GenerationPipeline& operator=(const GenerationPipeline&) = delete;
+    
+    /*
+     Ejecuta una generacion (equivalente a geneticAlgorithmStep)
+     
+     population: Poblacion actual, evaluada y ordenada (capacidad generationCapacity)
+     nextPopulation: Poblacion auxiliar (capacidad generationCapacity)
+     archive: Archivo de Pareto (opcional), actualizado en el mismo orden que en geneticAlgorithmStep
+     firstFronts: Primer frente de cada capa de la nueva poblacion (opcional, ver fastNonDominatedSort)
+     */
+    void step(Population& population, Population& nextPopulation, RandomEngine& rng, ParetoArchive* archive = nullptr,
+              vector<vector<int>>* firstFronts = nullptr) {
+        selectParents(population, populationSize, parents, rng);
+        size_t firstOffspring = population.size();
+        population.resize(firstOffspring + (parents.size() + 1) / 2 * 2);
+        
+        // Con truncamiento los hijos se mutan antes de evaluarse (como en geneticAlgorithmStep)
+        const bool elitist = survivorSelection == SurvivorSelection::Truncation;
+        beginPhase(population);
+        for (size_t i = 0; i < parents.size(); i += 2) {
+            const LayerSelection& parent1 = parents[i];
+            const LayerSelection& parent2 = parents[(i + 1) % parents.size()];
+            uniformCrossover(population, parent1, parent2, population[firstOffspring + i], population[firstOffspring + i + 1], rng, 0.8, mask);
+            if (!elitist) {
+                submit(firstOffspring + i);
+                submit(firstOffspring + i + 1);
+            }
+        }
+        for (size_t i = firstOffspring; elitist && i < population.size(); i++) {
+            mutateIndividual(population[i], rng);
+            submit(i);
+        }
+        for (size_t i = 0; i < population.size(); i++) {
+            if (i >= firstOffspring) {
+                waitFor(i);
+            }
+            if (archive != nullptr) archive->offer(population[i]);
+            if (!elitist) mutateIndividual(population[i], rng);
+            for (auto& chromosome : population[i].chromosomes) {
+                chromosome.domLevel = -1;
+                chromosome.crowdingDistance = -1;
+            }
+        }
+        endPhase();
+        fastNonDominatedSort(population, &pool);
+        
+        selectSurvivorIndices(population, populationSize, survivors, survivorSelection, rng);
+        nextPopulation.resize(populationSize);
+        beginPhase(nextPopulation);
+        for (int i = 0; i < populationSize; i++) {
+            copySelection(population, survivors[i], nextPopulation[i]);
+            submit(i);
+        }
+        endPhase();
+        if (archive != nullptr) archive->update(nextPopulation);
+        swap(population, nextPopulation);
+        fastNonDominatedSort(population, &pool, firstFronts);
+    }
+    
+    // Individuos evaluados por la tuberia (sin la poblacion inicial)
+    long getEvaluations() const {
+        return evaluations;
+    }
+    
+private:
+    const ScenarioData& data;
+    int populationSize;
+    ThreadPool& pool;
+    FitnessCache* cache;
+    int checkpointInterval;
+    SurvivorSelection survivorSelection;
+    WorkQueue tasks; // Individuos de target por evaluar
+    unique_ptr<atomic<bool>[]> ready; // ready[i]: el individuo i de target ya no esta pendiente
+    Population* target; // Poblacion de la fase actual
+    atomic<int> outstanding; // Individuos entregados y aun no evaluados
+    long evaluations; // Individuos entregados desde que se creo la tuberia
+    vector<EvaluationScratch> scratch;
+    vector<thread> workers;
+    mutex phaseMutex;
+    condition_variable phaseStarted;
+    unsigned long long phase;
+    atomic<bool> phaseOpen;
+    atomic<bool> stopping;
+    atomic<bool> failed;
+    WakeSignal taskReady; // Trabajadores esperando individuos de la fase
+    WakeSignal taskDone; // Coordinador esperando evaluaciones
+    mutex errorMutex;
+    exception_ptr firstError;
+    vector<LayerSelection> parents;
+    vector<LayerSelection> survivors;
+    vector<uint64_t> mask;
+    
+    // Abre una fase: los trabajadores evaluan individuos de population hasta endPhase
+    void beginPhase(Population& population) {
+        for (size_t i = 0; i < population.capacity(); i++) {
+            ready[i].store(false, memory_order_relaxed);
+        }
+        {
+            lock_guard<mutex> lock(phaseMutex);
+            target = &population;
+            phase++;
+            phaseOpen.store(true);
+        }
+        phaseStarted.notify_all();
+    }
+    
+    // Entrega un individuo a los trabajadores si tiene cromosomas por evaluar
+    void submit(size_t index) {
+        if (!(*target)[index].isDirty()) {
+            ready[index].store(true, memory_order_relaxed);
+            return;
+        }
+        evaluations++;
+        outstanding.fetch_add(1, memory_order_relaxed);
+        tasks.push(int(index));
+        taskReady.notify();
+    }
+    
+    // Evalua un individuo pendiente (desde un trabajador o desde el coordinador)
+    void runTask(int index, int workerId) {
+        try {
+            evaluateIndividual((*target)[index], data, scratch[workerId], cache, checkpointInterval);
+        } catch (...) {
+            lock_guard<mutex> lock(errorMutex);
+            if (!firstError) firstError = current_exception();
+            failed.store(true, memory_order_release);
+        }
+        ready[index].store(true, memory_order_release);
+        outstanding.fetch_sub(1, memory_order_acq_rel);
+        taskDone.notify();
+    }
+    
+    /*
+     Evalua pendientes desde el coordinador hasta que done devuelva true
+     
+     Si no quedan pendientes en la cola, duerme hasta que un trabajador
+     termine alguno de los que tiene en curso.
+     
+     done: Condicion de salida (solo puede cambiar cuando termina una evaluacion)
+     */
+    template <typename Predicate>
+    void evaluateUntil(Predicate done) {
+        int task;
+        while (!done()) {
+            if (!tasks.pop(task)) {
+                bool popped = false;
+                taskDone.wait([&]() { return done() || (popped = tasks.pop(task)); });
+                if (!popped) continue;
+            }
+            runTask(task, 0);
+        }
+    }
+    
+    // Espera a que un individuo este evaluado, evaluando pendientes mientras tanto
+    void waitFor(size_t index) {
+        evaluateUntil([&]() { return ready[index].load(memory_order_acquire); });
+        checkFailure();
+    }
+    
+    // Espera a que se evaluen todos los individuos entregados y cierra la fase
+    void endPhase() {
+        evaluateUntil([&]() { return outstanding.load(memory_order_acquire) == 0; });
+        closePhase();
+        checkFailure();
+    }
+    
+    // Manda a los trabajadores de vuelta a esperar la fase siguiente
+    void closePhase() {
+        phaseOpen.store(false);
+        taskReady.notify(true);
+    }
+    
+    void checkFailure() {
+        if (!failed.load(memory_order_acquire)) return;
+        evaluateUntil([&]() { return outstanding.load(memory_order_acquire) == 0; });
+        closePhase();
+        failed.store(false);
+        exception_ptr error;
+        swap(error, firstError);
+        rethrow_exception(error);
+    }
+    
+    void workerLoop(int workerId) {
+        unsigned long long seenPhase = 0;
+        while (true) {
+            {
+                unique_lock<mutex> lock(phaseMutex);
+                phaseStarted.wait(lock, [&]() { return stopping.load() || (phaseOpen.load() && phase != seenPhase); });
+                if (stopping.load()) return;
+                seenPhase = phase;
+            }
+            // Sin individuos en la cola, duerme hasta que submit entregue otro o se cierre la fase
+            while (true) {
+                int task;
+                if (!tasks.pop(task)) {
+                    bool popped = false;
+                    taskReady.wait([&]() { return !phaseOpen.load(memory_order_acquire) || (popped = tasks.pop(task)); });
+                    if (!popped) break;
+                }
+                runTask(task, workerId);
+            }
+        }
+    }
+};
+
+// FORMATO DE INTERCAMBIO ENTRE PROCESOS
+
+const uint32_t WIRE_MAGIC = 0x494c4f50; // "POLI"
+const uint32_t WIRE_BYTE_ORDER = 0x01020304;
+
+/*
+ WireHeader
+ Encabezado de un mensaje con cromosomas serializados
+ 
+ Despues del encabezado va cada cromosoma como: politica (1 byte), genes
+ (numGenes valores de geneBytes bytes) y f1, f2 (double). No se envian
+ checkpoints ni el orden (domLevel, crowding): quien recibe vuelve a ordenar.
+ Los mensajes solo se intercambian entre procesos con el mismo orden de
+ bytes y el mismo tipo de gen (byteOrder y geneBytes lo verifican).
+ 
+ epoch: Numero de migracion (-1 si el mensaje es una poblacion completa)
+ sourceIsland: Isla (global) que envia los emigrantes
+ layerCounts: Emigrantes por capa (los cromosomas van agrupados por capa)
+ */
+struct WireHeader {
+    uint32_t magic;
+    uint32_t byteOrder;
+    uint32_t geneBytes;
+    int32_t numGenes;
+    int32_t numChromosomes;
+    int32_t epoch;
+    int32_t sourceIsland;
+    int32_t layerCounts[NUM_POLICIES];
+};
+
+/*
+ Crea un mensaje vacio con su encabezado
+ */
+vector<char> beginWireMessage(int numGenes, int numChromosomes, int epoch, int sourceIsland, const array<int, NUM_POLICIES>& layerCounts) {
+    WireHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = WIRE_MAGIC;
+    header.byteOrder = WIRE_BYTE_ORDER;
+    header.geneBytes = sizeof(Gene);
+    header.numGenes = numGenes;
+    header.numChromosomes = numChromosomes;
+    header.epoch = epoch;
+    header.sourceIsland = sourceIsland;
+    for (int c = 0; c < NUM_POLICIES; c++) {
+        header.layerCounts[c] = layerCounts[c];
+    }
+    vector<char> message(sizeof(header));
+    message.reserve(sizeof(header) + size_t(numChromosomes) * (1 + numGenes * sizeof(Gene) + 2 * sizeof(double)));
+    memcpy(message.data(), &header, sizeof(header));
+    return message;
+}
+
+/*
+ Agrega un cromosoma (politica, genes, f1, f2) al final de un mensaje
+ */
+void writeWireChromosome(vector<char>& message, const Chromosome& chromosome) {
+    size_t offset = message.size();
+    size_t geneBytes = size_t(chromosome.size()) * sizeof(Gene);
+    message.resize(offset + 1 + geneBytes + 2 * sizeof(double));
+    char* out = message.data() + offset;
+    *out++ = char(chromosome.policy);
+    memcpy(out, chromosome.genes, geneBytes);
+    out += geneBytes;
+    memcpy(out, &chromosome.f1, sizeof(double));
+    memcpy(out + sizeof(double), &chromosome.f2, sizeof(double));
+}
+
+/*
+ Valida un mensaje y devuelve su encabezado
+ 
+ message: Mensaje recibido
+ numGenes: Genes por cromosoma esperados
+ */
+WireHeader readWireHeader(const vector<char>& message, int numGenes) {
+    WireHeader header;
+    if (message.size() < sizeof(header)) {
+        throw runtime_error("ERROR: Mensaje entre procesos incompleto");
+    }
+    memcpy(&header, message.data(), sizeof(header));
+    if (header.magic != WIRE_MAGIC || header.byteOrder != WIRE_BYTE_ORDER || header.geneBytes != sizeof(Gene)) {
+        throw runtime_error("ERROR: Mensaje entre procesos con formato incompatible");
+    }
+    size_t chromosomeBytes = 1 + size_t(numGenes) * sizeof(Gene) + 2 * sizeof(double);
+    if (header.numGenes != numGenes || header.numChromosomes < 0 ||
+        size_t(header.numChromosomes) > (message.size() - sizeof(header)) / chromosomeBytes ||
+        message.size() != sizeof(header) + size_t(header.numChromosomes) * chromosomeBytes) {
+        throw runtime_error("ERROR: Mensaje entre procesos con tamaño inconsistente");
+    }
+    return header;
+}
+
+/*
+ Lee un cromosoma de un mensaje y lo deja evaluado (sin checkpoints)
+ 
+ cursor: Posicion del cromosoma dentro del mensaje
+ chromosome: Cromosoma destino (del mismo tamaño); su politica debe coincidir con la del mensaje
+ const char*: Posicion del siguiente cromosoma
+ */
+const char* readWireChromosome(const char* cursor, Chromosome& chromosome) {
+    size_t geneBytes = size_t(chromosome.size()) * sizeof(Gene);
+    if (static_cast<unsigned char>(*cursor++) != static_cast<unsigned char>(chromosome.policy)) {
+        throw runtime_error("ERROR: Mensaje entre procesos con un cromosoma de otra politica");
+    }
+    chromosome.reset();
+    memcpy(chromosome.genes, cursor, geneBytes);
+    cursor += geneBytes;
+    memcpy(&chromosome.f1, cursor, sizeof(double));
+    memcpy(&chromosome.f2, cursor + sizeof(double), sizeof(double));
+    chromosome.markClean();
+    return cursor + 2 * sizeof(double);
+}
+
+/*
+ Serializa todos los cromosomas de una poblacion (individuo por individuo)
+ */
+vector<char> serializePopulation(const Population& population) {
+    array<int, NUM_POLICIES> noLayers;
+    noLayers.fill(0);
+    vector<char> message = beginWireMessage(population.getNumGenes(), population.size() * NUM_POLICIES, -1, -1, noLayers);
+    for (const Individual& individual : population) {
+        for (const Chromosome& chromosome : individual.chromosomes) {
+            writeWireChromosome(message, chromosome);
+        }
+    }
+    return message;
+}
+
+/*
+ Copia los individuos de un mensaje de serializePopulation a partir de una posicion
+ 
+ firstIndex: Posicion del primer individuo en population
+ size_t: Numero de individuos leidos
+ */
+size_t deserializePopulation(const vector<char>& message, Population& population, size_t firstIndex) {
+    WireHeader header = readWireHeader(message, population.getNumGenes());
+    size_t numIndividuals = header.numChromosomes / NUM_POLICIES;
+    if (header.numChromosomes % NUM_POLICIES != 0 || firstIndex > population.size() ||
+        numIndividuals > population.size() - firstIndex) {
+        throw runtime_error("ERROR: Mensaje de poblacion que no cabe en la poblacion destino");
+    }
+    const char* cursor = message.data() + sizeof(WireHeader);
+    for (size_t i = 0; i < numIndividuals; i++) {
+        for (Chromosome& chromosome : population[firstIndex + i].chromosomes) {
+            cursor = readWireChromosome(cursor, chromosome);
+        }
+    }
+    return numIndividuals;
+}
+
+/*
+ Serializa un archivo de Pareto
+ 
+ Los puntos van agrupados por capa (layerCounts) y de cada uno se envia el
+ individuo completo; al recibirlo solo cuenta el fitness de su capa.
+ */
+vector<char> serializeArchive(const ParetoArchive& archive) {
+    array<int, NUM_POLICIES> counts;
+    int total = 0;
+    for (int c = 0; c < NUM_POLICIES; c++) {
+        counts[c] = archive.size(c);
+        total += counts[c];
+    }
+    vector<char> message = beginWireMessage(archive.getNumGenes(), total * NUM_POLICIES, -1, -1, counts);
+    for (int c = 0; c < NUM_POLICIES; c++) {
+        for (int k = 0; k < counts[c]; k++) {
+            for (const Chromosome& chromosome : archive.entry(c, k).chromosomes) {
+                writeWireChromosome(message, chromosome);
+            }
+        }
+    }
+    return message;
+}
+
+/*
+ Agrega a un archivo los puntos de un mensaje de serializeArchive
+ */
+void mergeArchiveMessage(const vector<char>& message, ParetoArchive& archive) {
+    WireHeader header = readWireHeader(message, archive.getNumGenes());
+    long total = 0;
+    for (int c = 0; c < NUM_POLICIES; c++) {
+        if (header.layerCounts[c] < 0) {
+            throw runtime_error("ERROR: Mensaje de archivo de Pareto con conteos inconsistentes");
+        }
+        total += header.layerCounts[c];
+    }
+    if (total * NUM_POLICIES != header.numChromosomes) {
+        throw runtime_error("ERROR: Mensaje de archivo de Pareto con conteos inconsistentes");
+    }
+    Population scratch(1, archive.getNumGenes());
+    const char* cursor = message.data() + sizeof(WireHeader);
+    for (int c = 0; c < NUM_POLICIES; c++) {
+        for (int k = 0; k < header.layerCounts[c]; k++) {
+            for (Chromosome& chromosome : scratch[0].chromosomes) {
+                cursor = readWireChromosome(cursor, chromosome);
+            }
+            archive.offer(scratch[0], c);
+        }
+    }
+}
+
+// PROCESOS COOPERANTES (MPI)
+
+/*
+ ProcessGroup
+ Procesos que participan en una misma corrida
+ 
+ Con -DPOLIPLOIDES_MPI (compilando con mpicxx) cada rank de MPI es un
+ proceso que corre sus propias islas, y las migraciones entre islas de
+ procesos distintos viajan como mensajes con el formato de WireHeader. Sin
+ MPI el grupo tiene un solo proceso.
+ 
+ Las islas de un proceso llaman send/receive desde sus propios hilos; todas
+ las llamadas a MPI quedan serializadas por un mutex y usan operaciones no
+ bloqueantes, de modo que basta con MPI_THREAD_SERIALIZED.
+ */
+class ProcessGroup {
+public:
+    ProcessGroup(int& argc, char**& argv) : processRank(0), numProcesses(1) {
+#if defined(POLIPLOIDES_MPI)
+        int provided;
+        MPI_Init_thread(&argc, &argv, MPI_THREAD_SERIALIZED, &provided);
+        if (provided < MPI_THREAD_SERIALIZED) {
+            MPI_Abort(MPI_COMM_WORLD, 1);
+        }
+        MPI_Comm_rank(MPI_COMM_WORLD, &processRank);
+        MPI_Comm_size(MPI_COMM_WORLD, &numProcesses);
+        void* tagUpperBound;
+        int found;
+        MPI_Comm_get_attr(MPI_COMM_WORLD, MPI_TAG_UB, &tagUpperBound, &found);
+        maxTag = found ? *static_cast<int*>(tagUpperBound) : 32767;
+#else
+        (void)argc;
+        (void)argv;
+#endif
+    }
+    
+    ~ProcessGroup() {
+#if defined(POLIPLOIDES_MPI)
+        flush();
+        MPI_Finalize();
+#endif
+    }
+    
+    ProcessGroup(const ProcessGroup&) = delete;
+    ProcessGroup& operator=(const ProcessGroup&) = delete;
+    
+    int rank() const { return processRank; }
+    int size() const { return numProcesses; }
+    bool isRoot() const { return processRank == 0; }
+    
+    /*
+     Envia un mensaje sin esperar a que llegue
+     */
+    void send(int destination, int tag, vector<char> message) {
+#if defined(POLIPLOIDES_MPI)
+        lock_guard<mutex> lock(mpiMutex);
+        pendingSends.emplace_back();
+        PendingSend& pending = pendingSends.back();
+        pending.message = move(message);
+        MPI_Isend(pending.message.data(), int(pending.message.size()), MPI_BYTE, destination, tag % maxTag,
+                  MPI_COMM_WORLD, &pending.request);
+        releaseCompletedSends();
+#else
+        (void)destination;
+        (void)tag;
+        (void)message;
+        throw runtime_error("ERROR: Envio entre procesos sin soporte de MPI");
+#endif
+    }
+    
+    /*
+     Espera un mensaje de un proceso
+     
+     aborted: Se activa si otra isla del proceso fallo (para no esperar indefinidamente)
+     */
+    vector<char> receive(int source, int tag, const atomic<bool>& aborted) {
+#if defined(POLIPLOIDES_MPI)
+        // Entre sondeos se duerme cada vez mas (hasta 1 ms) para no acaparar mpiMutex
+        chrono::microseconds backoff(10);
+        while (true) {
+            {
+                lock_guard<mutex> lock(mpiMutex);
+                int arrived = 0;
+                MPI_Status status;
+                MPI_Iprobe(source, tag % maxTag, MPI_COMM_WORLD, &arrived, &status);
+                if (arrived) {
+                    int count;
+                    MPI_Get_count(&status, MPI_BYTE, &count);
+                    vector<char> message(count);
+                    MPI_Recv(message.data(), count, MPI_BYTE, source, tag % maxTag, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+                    return message;
+                }
+                releaseCompletedSends();
+            }
+            if (aborted.load(memory_order_relaxed)) {
+                throw runtime_error("ERROR: Migracion interrumpida por una falla en otra isla");
+            }
+            this_thread::sleep_for(backoff);
+            backoff = min(backoff * 2, chrono::microseconds(1000));
+        }
+#else
+        (void)source;
+        (void)tag;
+        (void)aborted;
+        throw runtime_error("ERROR: Recepcion entre procesos sin soporte de MPI");
+#endif
+    }
+    
+    /*
+     Espera a que se entreguen todos los mensajes enviados
+     */
+    void flush() {
+#if defined(POLIPLOIDES_MPI)
+        lock_guard<mutex> lock(mpiMutex);
+        for (auto& pending : pendingSends) {
+            MPI_Wait(&pending.request, MPI_STATUS_IGNORE);
+        }
+        pendingSends.clear();
+#endif
+    }
+    
+    /*
+     Maximo de un valor entre todos los procesos
+     */
+    double maxAll(double value) {
+#if defined(POLIPLOIDES_MPI)
+        double result;
+        MPI_Allreduce(&value, &result, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+        return result;
+#else
+        return value;
+#endif
+    }
+    
+    /*
+     Reune en el proceso 0 un mensaje de cada proceso (en orden de rank)
+     
+     vector<vector<char>>: Mensajes de todos los procesos (vacio fuera del proceso 0)
+     */
+    vector<vector<char>> gatherToRoot(const vector<char>& message) {
+#if defined(POLIPLOIDES_MPI)
+        int length = message.size();
+        vector<int> lengths(isRoot() ? numProcesses : 0);
+        MPI_Gather(&length, 1, MPI_INT, lengths.data(), 1, MPI_INT, 0, MPI_COMM_WORLD);
+        vector<int> offsets(lengths.size(), 0);
+        for (size_t p = 1; p < lengths.size(); p++) {
+            offsets[p] = offsets[p - 1] + lengths[p - 1];
+        }
+        vector<char> all(isRoot() ? offsets.back() + lengths.back() : 0);
+        MPI_Gatherv(message.data(), length, MPI_BYTE, all.data(), lengths.data(), offsets.data(), MPI_BYTE, 0, MPI_COMM_WORLD);
+        vector<vector<char>> messages;
+        for (size_t p = 0; p < lengths.size(); p++) {
+            messages.emplace_back(all.begin() + offsets[p], all.begin() + offsets[p] + lengths[p]);
+        }
+        return messages;
+#else
+        return {message};
+#endif
+    }
+    
+    /*
+     Termina todos los procesos despues de un error en uno de ellos
+     */
+    void abortAll() {
+#if defined(POLIPLOIDES_MPI)
+        if (numProcesses > 1) {
+            MPI_Abort(MPI_COMM_WORLD, 1);
+        }
+#endif
+    }
+    
+private:
+    int processRank;
+    int numProcesses;
+#if defined(POLIPLOIDES_MPI)
+    struct PendingSend {
+        vector<char> message;
+        MPI_Request request;
+    };
+    int maxTag;
+    mutex mpiMutex;
+    deque<PendingSend> pendingSends;
+    
+    void releaseCompletedSends() {
+        while (!pendingSends.empty()) {
+            int done = 0;
+            MPI_Test(&pendingSends.front().request, &done, MPI_STATUS_IGNORE);
+            if (!done) break;
+            pendingSends.pop_front();
+        }
+    }
+#endif
+};
+
+// MODELO DE ISLAS
+
+// Forma en que las islas eligen de quien reciben emigrantes
+enum class MigrationTopology {
+    Ring,   // La isla i recibe de la isla i - 1
+    Random  // En cada migracion, cada isla recibe de otra isla al azar
+};
+
+/*
+ IslandSettings
+ Parametros del modelo de islas
+ 
+ numIslands: Numero de islas (cada una en su propio hilo)
+ migrationInterval: Generaciones entre dos migraciones (0 para no migrar)
+ migrantsPerLayer: Cromosomas del frente 1 que emigran por capa
+ topology: Topologia de migracion
+ */
+struct IslandSettings {
+    int numIslands;
+    int migrationInterval;
+    int migrantsPerLayer;
+    MigrationTopology topology;
+    
+    IslandSettings() : numIslands(1), migrationInterval(10), migrantsPerLayer(2), topology(MigrationTopology::Ring) {}
+};
+
+/*
+ Copia emigrantes sobre los peores cromosomas de cada capa de una poblacion
+ 
+ Reemplaza, por capa, los cromosomas de mayor nivel de dominancia (y menor
+ crowding). La poblacion debe volver a ordenarse despues.
+ 
+ population: Poblacion que recibe (ordenada)
+ migrants: migrants[k].chromosomes[c] es el k-esimo emigrante de la capa c
+ counts: Emigrantes por capa
+ */
+void replaceWorst(Population& population, const Population& migrants, const array<int, NUM_POLICIES>& counts) {
+    vector<int> order(population.size());
+    for (int c = 0; c < NUM_POLICIES; c++) {
+        iota(order.begin(), order.end(), 0);
+        auto layer = [&population, c](int index) -> const Chromosome& {
+            return population[index].chromosomes[c];
+        };
+        stable_sort(order.begin(), order.end(), [&layer](int a, int b) {
+            if (layer(a).domLevel != layer(b).domLevel) return layer(a).domLevel > layer(b).domLevel;
+            return layer(a).crowdingDistance < layer(b).crowdingDistance;
+        });
+        for (int k = 0; k < counts[c] && k < static_cast<int>(order.size()); k++) {
+            population[order[k]].chromosomes[c].copyFrom(migrants[k].chromosomes[c]);
+        }
+    }
+}
+
+/*
+ MigrationMailbox
+ Buzon con los emigrantes que publica una isla en cada migracion
+ 
+ La isla duena publica sus emigrantes de la epoca e y las islas que la tienen
+ como origen los leen. Antes de publicar la epoca e + 1 la duena espera a que
+ todos los lectores de la epoca e terminen, y cada lector espera a que la
+ epoca que necesita este publicada. El protocolo usa dos atomicos
+ (publishedEpoch, pendingReads); quien tiene que esperar duerme en una
+ condition_variable que se avisa al publicar, al terminar cada lectura y
+ al interrumpir. Como los emigrantes de cada epoca quedan fijados por la
+ logica del algoritmo y no por el orden de los hilos, el resultado es
+ reproducible.
+ 
+ migrantsPerLayer: Maximo de cromosomas por capa
+ numGenes: Genes por cromosoma
+ */
+class MigrationMailbox {
+public:
+    MigrationMailbox(int migrantsPerLayer, int numGenes)
+        : migrants(migrantsPerLayer, numGenes), publishedEpoch(-1), pendingReads(0) {
+        counts.fill(0);
+    }
+    
+    /*
+     Publica los mejores cromosomas de cada capa de una poblacion ordenada
+     
+     Por capa emigran los cromosomas del frente 1 con mayor crowding distance.
+     
+     epoch: Numero de migracion
+     population: Poblacion de la isla duena (domLevel y crowding asignados)
+     numReaders: Islas que leeran esta epoca
+     aborted: Se activa si otra isla fallo (para no esperar indefinidamente)
+     */
+    void publish(int epoch, const Population& population, int numReaders, const atomic<bool>& aborted) {
+        waitOrAbort([this]() { return pendingReads.load(memory_order_acquire) == 0; }, aborted);
+        vector<int> order(population.size());
+        for (int c = 0; c < NUM_POLICIES; c++) {
+            iota(order.begin(), order.end(), 0);
+            auto layer = [&population, c](int index) -> const Chromosome& {
+                return population[index].chromosomes[c];
+            };
+            auto newEnd = remove_if(order.begin(), order.end(), [&layer](int index) { return layer(index).domLevel != 1; });
+            order.erase(newEnd, order.end());
+            stable_sort(order.begin(), order.end(), [&layer](int a, int b) {
+                return layer(a).crowdingDistance > layer(b).crowdingDistance;
+            });
+            counts[c] = min<int>(order.size(), migrants.size());
+            for (int k = 0; k < counts[c]; k++) {
+                migrants[k].chromosomes[c].copyFrom(layer(order[k]));
+            }
+            order.resize(population.size());
+        }
+        pendingReads.store(numReaders, memory_order_relaxed);
+        publishedEpoch.store(epoch, memory_order_release);
+        interrupt();
+    }
+    
+    /*
+     Copia los emigrantes de una epoca sobre los peores cromosomas de cada capa
+     (ver replaceWorst). La poblacion debe volver a ordenarse despues.
+     
+     epoch: Numero de migracion
+     population: Poblacion de la isla que recibe
+     aborted: Se activa si otra isla fallo (para no esperar indefinidamente)
+     */
+    void receive(int epoch, Population& population, const atomic<bool>& aborted) {
+        waitOrAbort([this, epoch]() { return publishedEpoch.load(memory_order_acquire) >= epoch; }, aborted);
+        replaceWorst(population, migrants, counts);
+        if (pendingReads.fetch_sub(1, memory_order_acq_rel) == 1) {
+            interrupt();
+        }
+    }
+    
+    /*
+     Despierta a quien espera en el buzon para que vuelva a revisar su condicion
+     Se llama tambien despues de activar aborted, para que nadie quede dormido.
+     */
+    void interrupt() {
+        {
+            lock_guard<mutex> lock(waitMutex);
+        }
+        changed.notify_all();
+    }
+    
+    /*
+     Serializa los emigrantes publicados para enviarlos a otro proceso
+     Solo la isla duena debe llamarlo, justo despues de publish.
+     */
+    vector<char> serialize(int epoch, int sourceIsland) const {
+        int total = 0;
+        for (int count : counts) total += count;
+        vector<char> message = beginWireMessage(migrants.getNumGenes(), total, epoch, sourceIsland, counts);
+        for (int c = 0; c < NUM_POLICIES; c++) {
+            for (int k = 0; k < counts[c]; k++) {
+                writeWireChromosome(message, migrants[k].chromosomes[c]);
+            }
+        }
+        return message;
+    }
+    
+    /*
+     Copia los emigrantes de un mensaje de serialize sobre los peores cromosomas de cada capa
+     
+     message: Mensaje recibido
+     epoch, sourceIsland: Migracion y origen esperados
+     population: Poblacion de la isla que recibe
+     scratch: Poblacion auxiliar con capacidad para los emigrantes de una capa
+     */
+    static void receiveMessage(const vector<char>& message, int epoch, int sourceIsland, Population& population, Population& scratch) {
+        WireHeader header = readWireHeader(message, population.getNumGenes());
+        if (header.epoch != epoch || header.sourceIsland != sourceIsland) {
+            throw runtime_error("ERROR: Mensaje de migracion inesperado (epoca " + to_string(header.epoch) +
+                                ", isla " + to_string(header.sourceIsland) + ")");
+        }
+        array<int, NUM_POLICIES> counts;
+        int total = 0;
+        for (int c = 0; c < NUM_POLICIES; c++) {
+            counts[c] = header.layerCounts[c];
+            if (counts[c] < 0 || counts[c] > static_cast<int>(scratch.size())) {
+                throw runtime_error("ERROR: Mensaje de migracion con demasiados emigrantes");
+            }
+            total += counts[c];
+        }
+        if (total != header.numChromosomes) {
+            throw runtime_error("ERROR: Mensaje de migracion con conteos inconsistentes");
+        }
+        const char* cursor = message.data() + sizeof(WireHeader);
+        for (int c = 0; c < NUM_POLICIES; c++) {
+            for (int k = 0; k < counts[c]; k++) {
+                cursor = readWireChromosome(cursor, scratch[k].chromosomes[c]);
+            }
+        }
+        replaceWorst(population, scratch, counts);
+    }
+    
+private:
+    Population migrants; // migrants[k].chromosomes[c]: k-esimo emigrante de la capa c
+    array<int, NUM_POLICIES> counts;
+    atomic<int> publishedEpoch;
+    atomic<int> pendingReads;
+    mutex waitMutex;
+    condition_variable changed; // Se publico una epoca, termino una lectura o se interrumpio
+    
+    // Duerme hasta que ready devuelva true; lanza si antes se activa aborted
+    template <typename Predicate>
+    void waitOrAbort(Predicate ready, const atomic<bool>& aborted) {
+        if (ready()) return;
+        unique_lock<mutex> lock(waitMutex);
+        changed.wait(lock, [&]() { return ready() || aborted.load(); });
+        if (!ready()) {
+            throw runtime_error("ERROR: Migracion interrumpida por una falla en otra isla");
+        }
+    }
+};
+
+/*
+ IslandModel
+ Ejecuta varias poblaciones (islas) independientes en paralelo, con migracion periodica
+ 
+ Cada isla corre su propio ciclo de geneticAlgorithmStep en un hilo, con su
+ propio flujo del generador (RandomEngine(seed, isla)) y su propio evaluador;
+ la cache de fitness se comparte. Cada migrationInterval generaciones, cada
+ isla publica sus mejores cromosomas del frente 1 y recibe los de su isla de
+ origen segun la topologia. Con la misma semilla y configuracion el resultado
+ no depende del numero de hilos ni del orden en que avanzan las islas.
+ 
+ Si hay varios procesos, cada uno corre settings.numIslands islas y las islas
+ se numeran globalmente (proceso * numIslands + isla); la topologia y los
+ flujos del generador usan esa numeracion, por lo que repartir las mismas
+ islas entre hilos o entre procesos da el mismo resultado.
+ 
+ data: Datos del escenario
+ populationSize: Individuos por isla
+ seed: Semilla de la corrida
+ settings: Numero de islas y parametros de migracion
+ numThreads: Hilos de este proceso; cada isla evalua con numThreads / numIslands
+             (al menos uno, contando el hilo de la isla)
+ cache: Cache de fitness compartida (opcional)
+ checkpointInterval: Genes entre checkpoints de simulacion
+ useBatches: Evaluacion por lotes SIMD
+ processes: Procesos que comparten la corrida
+ archiveCapacity: Puntos por capa del archivo de Pareto de cada isla
+ survivorSelection: Torneos o truncamiento elitista
+ */
+class IslandModel {
+public:
+    IslandModel(const ScenarioData& data, int populationSize, uint64_t seed, const IslandSettings& settings, int numThreads,
+                FitnessCache* cache, int checkpointInterval, bool useBatches, ProcessGroup& processes, int archiveCapacity,
+                SurvivorSelection survivorSelection)
+        : data(data), populationSize(populationSize), seed(seed), settings(settings), survivorSelection(survivorSelection), processes(processes),
+          firstIsland(processes.rank() * settings.numIslands), aborted(false) {
+        const int threadsPerIsland = max(1, numThreads / settings.numIslands);
+        for (int i = 0; i < settings.numIslands; i++) {
+            islands.emplace_back(new Island(data, populationSize, RandomEngine(seed, firstIsland + i), threadsPerIsland, cache,
+                                            checkpointInterval, useBatches, settings.migrantsPerLayer, archiveCapacity));
+            mailboxes.emplace_back(new MigrationMailbox(settings.migrantsPerLayer, islands.back()->population.getNumGenes()));
+        }
+    }
+    
+    // Islas de este proceso
+    int getNumIslands() const {
+        return islands.size();
+    }
+    
+    // Islas de todos los procesos
+    int getTotalIslands() const {
+        return settings.numIslands * processes.size();
+    }
+    
+    // Hilos con los que evalua cada isla
+    int getThreadsPerIsland() const {
+        return islands[0]->pool.size();
+    }
+    
+    /*
+     Ejecuta numGenerations generaciones en todas las islas
+     
+     onGeneration(isla, generacion, poblacion) se llama desde el hilo de cada
+     isla al terminar cada generacion; solo debe tocar datos de esa isla.
+     */
+    void run(int numGenerations, const function<void(int, int, const Population&)>& onGeneration) {
+        planMigrations(numGenerations);
+        vector<exception_ptr> errors(islands.size());
+        auto runIsland = [&](int i) {
+            try {
+                evolveIsland(i, numGenerations, onGeneration);
+            } catch (...) {
+                errors[i] = current_exception();
+                aborted.store(true);
+                for (auto& mailbox : mailboxes) {
+                    mailbox->interrupt();
+                }
+            }
+        };
+        vector<thread> threads;
+        for (int i = 1; i < getNumIslands(); i++) {
+            threads.emplace_back(runIsland, i);
+        }
+        runIsland(0);
+        for (auto& t : threads) {
+            t.join();
+        }
+        processes.flush();
+        for (auto& error : errors) {
+            if (error) rethrow_exception(error);
+        }
+    }
+    
+    /*
+     Junta los archivos de Pareto de todas las islas en uno
+     
+     Con varios procesos todos deben llamarla; solo el archivo del proceso 0
+     recibe las islas de todos.
+     */
+    void collectArchive(ParetoArchive& archive) {
+        for (const auto& island : islands) {
+            archive.merge(island->archive);
+        }
+        if (processes.size() == 1) {
+            return;
+        }
+        vector<vector<char>> messages = processes.gatherToRoot(serializeArchive(archive));
+        for (size_t p = 1; p < messages.size(); p++) {
+            mergeArchiveMessage(messages[p], archive);
+        }
+    }
+    
+    /*
+     Junta los individuos de todas las islas en una sola poblacion (sin ordenar)
+     
+     Con varios procesos todos deben llamarla: el proceso 0 recibe las islas
+     de todos (en orden de rank) y los demas solo las suyas.
+     */
+    Population mergePopulations() const {
+        Population merged(islands.size() * populationSize, islands[0]->population.getNumGenes());
+        size_t next = 0;
+        for (const auto& island : islands) {
+            for (const Individual& individual : island->population) {
+                merged[next++].copyFrom(individual);
+            }
+        }
+        if (processes.size() == 1) {
+            return merged;
+        }
+        vector<vector<char>> messages = processes.gatherToRoot(serializePopulation(merged));
+        if (!processes.isRoot()) {
+            return merged;
+        }
+        Population all(getTotalIslands() * populationSize, merged.getNumGenes());
+        next = 0;
+        for (const auto& message : messages) {
+            next += deserializePopulation(message, all, next);
+        }
+        return all;
+    }
+    
+private:
+    // Estado propio de una isla: nada de esto se comparte entre hilos
+    struct Island {
+        RandomEngine rng;
+        ThreadPool pool; // Incluye al hilo de la isla
+        PopulationEvaluator evaluator;
+        Population population;
+        Population nextPopulation;
+        Population immigrants; // Emigrantes recibidos de otro proceso
+        ParetoArchive archive;
+        
+        Island(const ScenarioData& data, int populationSize, RandomEngine engine, int numThreads, FitnessCache* cache,
+               int checkpointInterval, bool useBatches, int migrantsPerLayer, int archiveCapacity)
+            : rng(engine), pool(numThreads), evaluator(data, pool, cache, checkpointInterval, useBatches),
+              archive(calculateTotalOperations(data), archiveCapacity) {
+            population = initializePopulation(populationSize, data, rng, generationCapacity(populationSize));
+            nextPopulation = Population(0, population.getNumGenes(), generationCapacity(populationSize));
+            immigrants = Population(migrantsPerLayer, population.getNumGenes());
+            evaluator.evaluate(population);
+            archive.update(population);
+            fastNonDominatedSort(population, &pool);
+        }
+    };
+    
+    const ScenarioData& data;
+    int populationSize;
+    uint64_t seed;
+    IslandSettings settings;
+    SurvivorSelection survivorSelection;
+    ProcessGroup& processes;
+    int firstIsland; // Numero global de la primera isla de este proceso
+    vector<unique_ptr<Island>> islands;
+    vector<unique_ptr<MigrationMailbox>> mailboxes;
+    vector<vector<int>> sources; // sources[epoca][isla global]: isla de la que recibe
+    vector<vector<int>> localReaders; // localReaders[epoca][isla global]: islas de este proceso que leen su buzon
+    atomic<bool> aborted;
+    
+    int processOf(int island) const {
+        return island / settings.numIslands;
+    }
+    
+    // Etiqueta del mensaje de migracion hacia una isla
+    int migrationTag(int epoch, int destinationIsland) const {
+        return epoch * getTotalIslands() + destinationIsland;
+    }
+    
+    /*
+     Decide de antemano de que isla recibe cada isla en cada migracion
+     */
+    void planMigrations(int numGenerations) {
+        const int numIslands = getTotalIslands();
+        int numEpochs = (settings.migrationInterval > 0 && numIslands > 1) ? (numGenerations - 1) / settings.migrationInterval : 0;
+        RandomEngine topologyRng(seed, numIslands);
+        sources.assign(numEpochs, vector<int>(numIslands));
+        localReaders.assign(numEpochs, vector<int>(numIslands, 0));
+        for (int e = 0; e < numEpochs; e++) {
+            for (int i = 0; i < numIslands; i++) {
+                int source;
+                if (settings.topology == MigrationTopology::Ring) {
+                    source = (i + numIslands - 1) % numIslands;
+                } else {
+                    source = topologyRng.nextBelow(numIslands - 1);
+                    if (source >= i) source++;
+                }
+                sources[e][i] = source;
+                if (processOf(i) == processes.rank()) {
+                    localReaders[e][source]++;
+                }
+            }
+        }
+    }
+    
+    /*
+     Publica los emigrantes de una isla y recibe los de su isla de origen
+     
+     i: Isla de este proceso
+     epoch: Numero de migracion
+     */
+    void migrate(int i, int epoch) {
+        Island& island = *islands[i];
+        const int global = firstIsland + i;
+        mailboxes[i]->publish(epoch, island.population, localReaders[epoch][global], aborted);
+        for (int reader = 0; reader < getTotalIslands(); reader++) {
+            if (sources[epoch][reader] == global && processOf(reader) != processes.rank()) {
+                processes.send(processOf(reader), migrationTag(epoch, reader), mailboxes[i]->serialize(epoch, global));
+            }
+        }
+        int source = sources[epoch][global];
+        if (processOf(source) == processes.rank()) {
+            mailboxes[source - firstIsland]->receive(epoch, island.population, aborted);
+        } else {
+            vector<char> message = processes.receive(processOf(source), migrationTag(epoch, global), aborted);
+            MigrationMailbox::receiveMessage(message, epoch, source, island.population, island.immigrants);
+        }
+        fastNonDominatedSort(island.population, &island.pool);
+    }
+    
+    void evolveIsland(int i, int numGenerations, const function<void(int, int, const Population&)>& onGeneration) {
+        Island& island = *islands[i];
+        for (int gen = 1; gen <= numGenerations; gen++) {
+            geneticAlgorithmStep(island.population, island.nextPopulation, populationSize, island.rng, island.evaluator, island.pool, &island.archive, survivorSelection);
+            int epoch = settings.migrationInterval > 0 ? gen / settings.migrationInterval - 1 : -1;
+            if (settings.migrationInterval > 0 && gen % settings.migrationInterval == 0 && epoch < static_cast<int>(sources.size())) {
+                migrate(i, epoch);
+            }
+            onGeneration(i, gen, island.population);
+        }
+    }
+};
+
+/*
+ Hipervolumen de un frente no dominado de una capa respecto a un punto de referencia
+ 
+ Con los puntos ordenados por f1, cada uno aporta la franja de ancho
+ (refF1 - f1) entre su f2 y el del ultimo punto contado (el mismo calculo
+ que hace HypervolumeTracker). Los puntos fuera de la caja de referencia no
+ aportan.
+ 
+ population: Poblacion a la que pertenece el frente
+ chromosomeIndex: Capa (politica) del frente
+ front: Indices de los individuos del frente, en orden de f1 creciente
+ refPointF1, refPointF2: Punto de referencia
+ */
+double frontHypervolume(const Population& population, int chromosomeIndex, const vector<int>& front, double refPointF1, double refPointF2) {
+    double hypervolume = 0.0;
+    double prevF2 = refPointF2;
+    
+    for (int index : front) {
+        double f1 = population[index].chromosomes[chromosomeIndex].f1;
+        double f2 = population[index].chromosomes[chromosomeIndex].f2;
+        
+        if (f1 < refPointF1 && f2 < prevF2) {
+            hypervolume += (refPointF1 - f1) * (prevF2 - f2);
+            prevF2 = f2;
+        }
+    }
+    return hypervolume;
+}
+
+/*
+ Hipervolumen del primer frente de una capa respecto a un punto de referencia
+ Junta los cromosomas con domLevel 1, los ordena por f1 y usa frontHypervolume.
+ */
+double calculateHyperVolume(const Population& population, int chromosomeIndex, double refPointF1, double refPointF2) {
+    vector<int> front;
+    for (size_t i = 0; i < population.size(); i++) {
+        if (population[i].chromosomes[chromosomeIndex].domLevel == 1) front.push_back(i);
+    }
+    sort(front.begin(), front.end(), [&population, chromosomeIndex](int a, int b) {
+        const Chromosome& A = population[a].chromosomes[chromosomeIndex];
+        const Chromosome& B = population[b].chromosomes[chromosomeIndex];
+        return A.f1 < B.f1 || (A.f1 == B.f1 && A.f2 < B.f2);
+    });
+    return frontHypervolume(population, chromosomeIndex, front, refPointF1, refPointF2);
+}
+
+/*
+ RunningStatistics
+ Minimo, maximo y promedio de una serie de valores, sin guardar la serie
+ */
+struct RunningStatistics {
+    long count = 0;
+    double minValue = numeric_limits<double>::infinity();
+    double maxValue = -numeric_limits<double>::infinity();
+    double sum = 0.0;
+    
+    void add(double value) {
+        count++;
+        minValue = min(minValue, value);
+        maxValue = max(maxValue, value);
+        sum += value;
+    }
+    
+    // Agrega los valores de otro resumen
+    void merge(const RunningStatistics& other) {
+        count += other.count;
+        minValue = min(minValue, other.minValue);
+        maxValue = max(maxValue, other.maxValue);
+        sum += other.sum;
+    }
+    
+    double mean() const {
+        return count > 0 ? sum / count : 0.0;
+    }
+};
+
+/*
+ Imprime el resumen del hipervolumen de cada politica hasta una generacion
+ 
+ generation: Generacion actual
+ statistics: Resumen de los valores registrados por politica (statistics[politica])
+ */
+void printHypervolumeTable(int generation, const vector<RunningStatistics>& statistics) {
+    printHeader("GENERACION " + to_string(generation), 50);
+    vector<vector<string>> hvTableValues;
+    vector<string> hvTableFields = {"Politica", "Min", "Max", "Promedio"};
+    for (size_t i=0; i<statistics.size(); i++){
+        vector<string> row;
+        row.push_back(policyNames[i]);
+        row.push_back(to_string(statistics[i].minValue));
+        row.push_back(to_string(statistics[i].maxValue));
+        row.push_back(to_string(statistics[i].mean()));
+        hvTableValues.push_back(row);
+    }
+    printTable(hvTableFields, hvTableValues);
+}
+
+// CONFIGURACION Y CRITERIOS DE PARADA
+
+/*
+ RunConfig
+ Tamano de la poblacion y criterios para terminar una corrida
+ 
+ La corrida termina con el primer criterio que se cumpla. El reloj del plazo
+ arranca con el escenario ya cargado, y los reportes finales no cuentan en
+ el. El modo estacionario revisa el plazo y el presupuesto despues de cada
+ hijo insertado. Los modos generacionales los revisan al final de cada
+ generacion, porque cortar una a la mitad dejaria la poblacion sin evaluar,
+ asi que pueden excederse en lo que tarde y evalue la generacion en curso.
+ El estancamiento se mide siempre por generacion.
+ */
+struct RunConfig {
+    int populationSize = 20;
+    int maxGenerations = 100;
+    long maxEvaluations = 0; // Individuos evaluados, contando la poblacion inicial (0: sin limite)
+    int deadlineMs = 0; // Plazo desde que se cargo el escenario, en milisegundos (0: sin limite)
+    int stagnationWindow = 0; // Generaciones sin mejora del hipervolumen (0: sin limite)
+    double stagnationTolerance = 0.0; // Mejora relativa minima para reiniciar la ventana
+    string frontFile; // Archivo donde se escribe el frente actual a pedido (vacio: ninguno)
+};
+
+/*
+ Lee un archivo de configuracion y agrega sus opciones a la lista de argumentos
+ 
+ Cada linea tiene una opcion de la linea de comandos sin los guiones y sus
+ valores (por ejemplo "deadline-ms 500" o "async"); lo que sigue a # se ignora.
+ Un archivo puede incluir otros con "config archivo", pero cada uno se
+ expande una sola vez: volver a incluirlo, directa o indirectamente, es un
+ error (si no, un archivo que se incluye a si mismo no terminaria nunca).
+ 
+ filename: Archivo de configuracion
+ args: Argumentos de la linea de comandos
+ position: Posicion donde se insertan las opciones leidas
+ expanded: Rutas de los archivos ya expandidos (se agrega filename)
+ */
+void expandConfigFile(const string& filename, vector<string>& args, size_t position, set<string>& expanded) {
+    ifstream file(filename);
+    if (!file.is_open()) {
+        throw runtime_error("ERROR: No se pudo abrir el archivo: " + filename);
+    }
+    if (!expanded.insert(filesystem::weakly_canonical(filename).string()).second) {
+        throw runtime_error("ERROR: El archivo de configuracion se incluye mas de una vez: " + filename);
+    }
+    vector<string> options;
+    string line;
+    while (getline(file, line)) {
+        line = line.substr(0, line.find('#'));
+        istringstream tokens(line);
+        string token;
+        if (!(tokens >> token)) continue;
+        options.push_back("--" + token);
+        while (tokens >> token) {
+            options.push_back(token);
+        }
+    }
+    args.insert(args.begin() + position, options.begin(), options.end());
+}
+
+/*
+ RunController
+ Decide si la corrida sigue, al final de cada generacion o en medio de ella
+ 
+ Lleva el reloj desde start() (o desde que se crea) y el mejor hipervolumen
+ de cada politica; la corrida se estanca cuando ninguna politica mejora el
+ suyo durante stagnationWindow generaciones seguidas.
+ 
+ config: Criterios de parada
+ */
+class RunController {
+public:
+    explicit RunController(const RunConfig& config) : config(config), lastImprovement(0) {
+        start();
+    }
+    
+    void start() {
+        startTime = chrono::steady_clock::now();
+    }
+    
+    long elapsedMs() const {
+        return chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - startTime).count();
+    }
+    
+    /*
+     Revisa el plazo y el presupuesto de evaluaciones (tambien en medio de una generacion)
+     
+     evaluations: Individuos evaluados hasta ahora, contando la poblacion inicial
+     bool: true si la corrida debe terminar
+     */
+    bool exhausted(long evaluations) {
+        if (config.maxEvaluations > 0 && evaluations >= config.maxEvaluations) {
+            stopReason = "presupuesto de " + to_string(config.maxEvaluations) + " evaluaciones";
+        } else if (config.deadlineMs > 0 && elapsedMs() >= config.deadlineMs) {
+            stopReason = "plazo de " + to_string(config.deadlineMs) + " ms";
+        } else {
+            return false;
+        }
+        return true;
+    }
+    
+    /*
+     Registra el hipervolumen de una generacion terminada
+     
+     generation: Generacion terminada
+     hypervolumes: Hipervolumen actual de cada politica
+     evaluations: Individuos evaluados hasta ahora, contando la poblacion inicial
+     bool: true si la corrida debe seguir
+     */
+    bool shouldContinue(int generation, const vector<double>& hypervolumes, long evaluations) {
+        best.resize(hypervolumes.size(), -numeric_limits<double>::infinity());
+        for (size_t i = 0; i < hypervolumes.size(); i++) {
+            if (hypervolumes[i] > best[i] + config.stagnationTolerance * fabs(best[i])) {
+                lastImprovement = generation;
+            }
+            best[i] = max(best[i], hypervolumes[i]);
+        }
+        if (generation >= config.maxGenerations) {
+            stopReason = "limite de generaciones";
+        } else if (exhausted(evaluations)) {
+            return false;
+        } else if (config.stagnationWindow > 0 && generation - lastImprovement >= config.stagnationWindow) {
+            stopReason = "hipervolumen estancado por " + to_string(config.stagnationWindow) + " generaciones";
+        } else {
+            return true;
+        }
+        return false;
+    }
+    
+    // Motivo por el que termino la corrida (vacio si sigue)
+    const string& getStopReason() const {
+        return stopReason;
+    }
+    
+private:
+    RunConfig config;
+    int lastImprovement; // Ultima generacion en la que alguna politica mejoro su hipervolumen
+    vector<double> best;
+    chrono::steady_clock::time_point startTime;
+    string stopReason;
+};
+
+// Pedido del frente actual (SIGUSR1); se atiende al final de la generacion en curso
+volatile sig_atomic_t frontRequested = 0;
+
+void requestFront(int) {
+    frontRequested = 1;
+}
+
+/*
+ Escribe el frente archivado de cada politica en un archivo de texto
+ 
+ Una linea por punto: politica, f1, f2 y los genes del cromosoma. Se escribe
+ en un archivo temporal que luego reemplaza al destino, para que quien lo lea
+ nunca vea un frente a medias.
+ 
+ archive: Archivo de Pareto con el mejor frente hasta ahora
+ filename: Archivo destino
+ */
+void writeParetoFront(const ParetoArchive& archive, const string& filename) {
+    const string temporary = filename + ".tmp";
+    {
+        ofstream file(temporary);
+        if (!file.is_open()) {
+            throw runtime_error("ERROR: No se pudo abrir el archivo: " + temporary);
+        }
+        file << "# politica f1 f2 genes" << endl;
+        for (int c = 0; c < NUM_POLICIES; c++) {
+            for (size_t k = 0; k < archive.size(c); k++) {
+                const Chromosome& chromosome = archive.entry(c, k).chromosomes[c];
+                file << policyNames[c] << " " << chromosome.f1 << " " << chromosome.f2;
+                for (int g = 0; g < chromosome.size(); g++) {
+                    file << " " << int(chromosome.genes[g]);
+                }
+                file << "\n";
+            }
+        }
+    }
+    if (rename(temporary.c_str(), filename.c_str()) != 0) {
+        throw runtime_error("ERROR: No se pudo escribir el archivo: " + filename);
     }
-    return newPopulation;
 }
 
-void mutationInterChromosome(Individual& individual, mt19937& rng, float mutationRate, uniform_real_distribution<double>& dist) {
-    if (dist(rng) < mutationRate){
-        uniform_int_distribution<int> distInt(0, individual.getNumChromosomes() - 1);
-        int a = distInt(rng);
-        int b;
-        do {
-            b = distInt(rng);
-        } while (b == a);
-        swap(individual.chromosomes[a].genes, individual.chromosomes[b].genes);
-    }
-}
+/*
+ Punto rodilla: el punto archivado (de cualquier capa) mas cercano al origen
+ */
+Individual& getKneePoint(ParetoArchive& archive) {
+    double refF1 = 0.0;
+    double refF2 = 0.0;
+    double minDistance = numeric_limits<double>::max();
+    Individual* kneePoint = nullptr;
 
-void mutationReciprocalExchange(Individual& individual, mt19937& rng, float mutationRate, uniform_real_distribution<double>& dist) {
-    if (dist(rng) < mutationRate){
-        uniform_int_distribution<int> distK(1, 3); // rango [1,3]
-        int n = individual.chromosomes[0].genes.size();
-        for (int c = 0; c < individual.getNumChromosomes(); c++){
-            int k = distK(rng);
-            vector<int> indexs(n);
-            iota(indexs.begin(), indexs.end(), 0);  // 0..n-1
-            shuffle(indexs.begin(), indexs.end(), rng);
+    for (int c = 0; c < NUM_POLICIES; c++) {
+        for (size_t k = 0; k < archive.size(c); k++) {
+            double f1 = archive.entry(c, k).chromosomes[c].f1;
+            double f2 = archive.entry(c, k).chromosomes[c].f2;
 
-            for (int pairCount = 0; pairCount < k; pairCount++) {
-                int i = indexs[2*pairCount];
-                int j = indexs[2*pairCount+1];
-                swap(individual.chromosomes[c].genes[i], individual.chromosomes[c].genes[j]);
+            double distance = sqrt(pow(refF2 - f2, 2) + pow(refF1 - f1, 2));
+
+            if (distance < minDistance) {
+                minDistance = distance;
+                kneePoint = &archive.entry(c, k);
             }
         }
     }
+    if (kneePoint == nullptr) {
+        throw runtime_error("ERROR: El archivo de Pareto esta vacio");
+    }
+    return *kneePoint;
 }
 
-void mutationShift(Individual& individual, mt19937& rng, float mutationRate, uniform_real_distribution<double>& dist){
-    if (dist(rng) < mutationRate){
-        uniform_int_distribution<int> distWindow(3, 5); 
-        int windowSize = distWindow(rng);
-        int n = individual.chromosomes[0].genes.size();
-        for (int c = 0; c < individual.getNumChromosomes(); c++){
-            uniform_int_distribution<int> distStart(0, n - windowSize);
-            int startIdx = distStart(rng);
-            vector<int> windowGenes;
-            for (int i = startIdx; i < startIdx + windowSize; i++) {
-                windowGenes.push_back(individual.chromosomes[c].genes[i]);
-            }
-            // Shift right
-            for (int i = startIdx + windowSize - 1; i > startIdx; i--) {
-                individual.chromosomes[c].genes[i] = individual.chromosomes[c].genes[i - 1];
-            }
-            individual.chromosomes[c].genes[startIdx] = windowGenes.back();
+/*
+ Menor makespan archivado: el primer punto de cada capa (el frente va por f1 creciente)
+ */
+Individual& getBestMakespan(ParetoArchive& archive) {
+    double bestMakespan = numeric_limits<double>::max();
+    Individual* bestIndividual = nullptr;
+
+    for (int c = 0; c < NUM_POLICIES; c++) {
+        if (archive.size(c) == 0) continue;
+        Individual& first = archive.entry(c, 0);
+        if (first.chromosomes[c].f1 < bestMakespan) {
+            bestMakespan = first.chromosomes[c].f1;
+            bestIndividual = &first;
         }
     }
+    if (bestIndividual == nullptr) {
+        throw runtime_error("ERROR: El archivo de Pareto esta vacio");
+    }
+    return *bestIndividual;
 }
 
-void graphParetoFront(const vector<Individual>& population) {
-    int numChrom = population[0].getNumChromosomes();
-
-    vector<vector<double>> x_vals(numChrom);
-    vector<vector<double>> y_vals(numChrom);
+/*
+ Menor energia archivada: el ultimo punto de cada capa (el frente va por f2 decreciente)
+ */
+Individual& getBestEnergy(ParetoArchive& archive) {
+    double bestEnergy = numeric_limits<double>::max();
+    Individual* bestIndividual = nullptr;
 
-    // Clasificar puntos por cromosoma
-    for (int c = 0; c < numChrom; c++) {
-        for (const Individual& ind : population) {
-            if (ind.chromosomes[c].domLevel == 1) {
-                x_vals[c].push_back(ind.chromosomes[c].f1);
-                y_vals[c].push_back(ind.chromosomes[c].f2);
-            }
+    for (int c = 0; c < NUM_POLICIES; c++) {
+        if (archive.size(c) == 0) continue;
+        Individual& last = archive.entry(c, archive.size(c) - 1);
+        if (last.chromosomes[c].f2 < bestEnergy) {
+            bestEnergy = last.chromosomes[c].f2;
+            bestIndividual = &last;
         }
     }
-
-    // Colores predefinidos
-    vector<string> colors = {"r", "g", "b", "m", "c", "y", "k"};
-
-    // Crear una figura
-    figure(true);
-    hold(on);
-
-    for (int c = 0; c < numChrom; c++) {
-        auto sc = scatter(x_vals[c], y_vals[c], 10);
-        sc->color(colors[c % colors.size()]);  // Reutiliza si hay más cromosomas que colores
-        sc->display_name("Cromosoma " + population[0].chromosomes[c].policyName); // Etiqueta
+    if (bestIndividual == nullptr) {
+        throw runtime_error("ERROR: El archivo de Pareto esta vacio");
     }
-
-    title("Poblacion - Distribucion de Makespan vs Energia");
-    xlabel("Makespan");
-    ylabel("Energia");
-
-    legend(); // <--- Agrega la leyenda automáticamente
-    hold(off);
-    show();
+    return *bestIndividual;
 }
 
-void graphPopulation(const vector<Individual>& population) {
-    int numChrom = population[0].getNumChromosomes();
-
-    vector<vector<double>> x_vals(numChrom);
-    vector<vector<double>> y_vals(numChrom);
+// PRUEBAS INTERNAS (--self-test)
 
-    // Clasificar puntos por cromosoma
-    for (int c = 0; c < numChrom; c++) {
-        for (const Individual& ind : population) {
-            x_vals[c].push_back(ind.chromosomes[c].f1);
-            y_vals[c].push_back(ind.chromosomes[c].f2);
+/*
+ Escribe un escenario de texto al azar (mismo formato que Escenario1.txt)
+ 
+ Los tiempos y energias son enteros, para que el texto los represente sin perdida.
+ 
+ filename: Archivo a escribir
+ numOperations, numMachines, numJobs: Dimensiones del escenario
+ rng: Generador de los valores
+ */
+void writeTestScenario(const string& filename, int numOperations, int numMachines, int numJobs, RandomEngine& rng) {
+    ofstream file(filename);
+    if (!file.is_open()) {
+        throw runtime_error("ERROR: No se pudo crear el archivo: " + filename);
+    }
+    for (const string& section : {string("# Tiempos de procesamiento"), string("# Consumo de energia")}) {
+        file << section << "\n";
+        for (int op = 0; op < numOperations; op++) {
+            for (int m = 0; m < numMachines; m++) {
+                file << (m > 0 ? " " : "") << 1 + rng.nextBelow(50);
+            }
+            file << "\n";
         }
     }
-
-    // Colores predefinidos
-    vector<string> colors = {"r", "g", "b", "m", "c", "y", "k"};
-
-    // Crear una figura
-    figure(true);
-    hold(on);
-
-    for (int c = 0; c < numChrom; c++) {
-        auto sc = scatter(x_vals[c], y_vals[c], 10);
-        sc->color(colors[c % colors.size()]);  // Reutiliza si hay más cromosomas que colores
-        sc->display_name("Cromosoma " + population[0].chromosomes[c].policyName); // Etiqueta
+    file << "# Trabajos\n";
+    for (int j = 0; j < numJobs; j++) {
+        int numOps = 1 + rng.nextBelow(5);
+        file << "J" << j + 1 << "={";
+        for (int k = 0; k < numOps; k++) {
+            file << (k > 0 ? "," : "") << "O" << 1 + rng.nextBelow(numOperations);
+        }
+        file << "}\n";
     }
-
-    title("Poblacion - Distribucion de Makespan vs Energia");
-    xlabel("Makespan");
-    ylabel("Energia");
-
-    legend(); // <--- Agrega la leyenda automáticamente
-    hold(off);
-    show();
 }
 
-vector<Individual> geneticAlgorithmStep(vector<Individual>& population, const ScenarioData& scenario, int populationSize, mt19937& rng) {
-    uniform_real_distribution<double> dist(0.0, 1.0);
+/*
+ TestScenario
+ Escenario al azar escrito en un archivo temporal, que se borra al destruir el objeto
+ */
+struct TestScenario {
+    string textFile;
+    ScenarioData data;
+    
+    TestScenario(uint64_t seed, int numOperations = 12, int numMachines = 5, int numJobs = 15) {
+        RandomEngine rng(seed);
+        textFile = testFileName("escenario_" + to_string(seed) + ".txt");
+        writeTestScenario(textFile, numOperations, numMachines, numJobs, rng);
+        data = loadScenario(textFile);
+    }
     
-    vector<Individual> parents = selectParents(population, populationSize);
-    vector<Individual> offspring = uniformCrossoverPopulation(parents, rng, 0.8, dist);
+    ~TestScenario() {
+        remove(textFile.c_str());
+    }
     
-    for (size_t i = 0; i < offspring.size(); i++){
-        string individuo = to_string(i+1);
-        evaluateAllPolicies(offspring[i], scenario, individuo, false, false);
+    // Ruta de un archivo temporal de las pruebas
+    static string testFileName(const string& name) {
+        return (filesystem::temp_directory_path() / ("poliploides_prueba_" + name)).string();
+    }
+};
+
+// Falla la prueba si action no lanza una excepcion
+void expectFailure(const function<void()>& action, const string& description) {
+    try {
+        action();
+    } catch (const exception&) {
+        return;
+    }
+    throw runtime_error(description + " no se rechazo");
+}
+
+/*
+ La imagen binaria de un escenario se carga igual que el texto del que salio
+ 
+ Compara dimensiones, matrices, trabajos y tablas de decodificacion valor por
+ valor, y revisa que una imagen truncada se rechace.
+ */
+void testBinaryMatchesText() {
+    TestScenario scenario(2, 14, 6, 12);
+    const string binaryFile = TestScenario::testFileName("escenario_2.bin");
+    const string truncatedFile = TestScenario::testFileName("escenario_2_truncado.bin");
+    compileScenario(scenario.data, binaryFile);
+    {
+        ifstream input(binaryFile, ios::binary);
+        string bytes((istreambuf_iterator<char>(input)), istreambuf_iterator<char>());
+        ofstream output(truncatedFile, ios::binary);
+        output.write(bytes.data(), bytes.size() / 2);
+    }
+    ScenarioData binary;
+    string error;
+    try {
+        binary = loadScenario(binaryFile);
+        expectFailure([&]() { loadScenario(truncatedFile); }, "la imagen truncada");
+    } catch (const exception& e) {
+        error = e.what();
+    }
+    remove(binaryFile.c_str());
+    remove(truncatedFile.c_str());
+    if (!error.empty()) {
+        throw runtime_error(error);
     }
     
-    vector<Individual> populationWithOffspring = population;
-    populationWithOffspring.insert(populationWithOffspring.end(), offspring.begin(), offspring.end());
-    for (int i=0; i<populationWithOffspring.size(); i++){
-        mutationInterChromosome(populationWithOffspring[i], rng, 0.3, dist);
-        mutationReciprocalExchange(populationWithOffspring[i], rng, 0.2, dist);
-        mutationShift(populationWithOffspring[i], rng, 0.1, dist);
-        for (int j=0; j<populationWithOffspring[i].chromosomes.size(); j++){
-            populationWithOffspring[i].chromosomes[j].domLevel = -1;
-            populationWithOffspring[i].chromosomes[j].crowdingDistance = -1;
+    const ScenarioData& text = scenario.data;
+    if (binary.numOperations != text.numOperations || binary.numMachines != text.numMachines ||
+        binary.numJobs != text.numJobs || binary.totalOperations != text.totalOperations) {
+        throw runtime_error("dimensiones distintas");
+    }
+    for (const auto& matrices : {make_pair(&text.processingTime, &binary.processingTime),
+                                 make_pair(&text.energyCost, &binary.energyCost)}) {
+        const CostMatrix& expected = *matrices.first;
+        const CostMatrix& actual = *matrices.second;
+        if (actual.numRows() != expected.numRows() || actual.numCols() != expected.numCols()) {
+            throw runtime_error("matrices de distinto tamano");
+        }
+        for (int row = 0; row < expected.numRows(); row++) {
+            if (!equal(expected[row], expected[row] + expected.numCols(), actual[row])) {
+                throw runtime_error("matrices distintas en la fila " + to_string(row));
+            }
         }
     }
-    fastNonDominatedSort(populationWithOffspring);
-    population = selectSurvivors(populationWithOffspring, populationSize);
-    for (int i=0; i<population.size(); i++){
-        for (int j=0; j<population[i].chromosomes.size(); j++){
-            population[i].chromosomes[j].domLevel = -1;
-            population[i].chromosomes[j].crowdingDistance = -1;
+    if (binary.jobs.size() != text.jobs.size()) {
+        throw runtime_error("distinto numero de trabajos");
+    }
+    for (size_t j = 0; j < text.jobs.size(); j++) {
+        if (binary.jobs[j].id != text.jobs[j].id || binary.jobs[j].operations != text.jobs[j].operations) {
+            throw runtime_error("trabajo " + to_string(j) + " distinto");
+        }
+    }
+    if (binary.decodeTables.size() != text.decodeTables.size()) {
+        throw runtime_error("distinto numero de tablas de decodificacion");
+    }
+    for (size_t c = 0; c < text.decodeTables.size(); c++) {
+        const auto& expected = text.decodeTables[c];
+        const auto& actual = binary.decodeTables[c];
+        if (actual.size() != expected.size() ||
+            !equal(expected.begin(), expected.end(), actual.begin(), [](const GeneDecode& a, const GeneDecode& b) {
+                return a.jobId == b.jobId && a.opId == b.opId;
+            })) {
+            throw runtime_error("tabla de decodificacion de " + policyNames[c] + " distinta");
         }
-        evaluateAllPolicies(population[i], scenario, to_string(i+1), false, false);
     }
-    fastNonDominatedSort(population);
-    return population;
 }
 
-double calculateHyperVolume(const vector<Individual>& population, int chromosomeIndex, double refPointF1, double refPointF2) {
-    vector<pair<double, double>> points;
-    for (const auto& ind : population) {
-        if (ind.chromosomes[chromosomeIndex].domLevel == 1)
-            points.push_back({ind.chromosomes[chromosomeIndex].f1, ind.chromosomes[chromosomeIndex].f2});
+// Si dos cromosomas tienen la misma politica, genes y fitness
+bool sameChromosome(const Chromosome& a, const Chromosome& b) {
+    return a.policy == b.policy && a.size() == b.size() && equal(a.genes, a.genes + a.size(), b.genes) &&
+           a.f1 == b.f1 && a.f2 == b.f2;
+}
+
+/*
+ Poblaciones y archivos de Pareto sobreviven el formato de intercambio entre procesos
+ 
+ Tambien revisa que se rechacen un mensaje truncado, uno que no cabe en la
+ poblacion destino y uno con un cromosoma de otra politica.
+ */
+void testWireRoundTrip() {
+    TestScenario scenario(18);
+    RandomEngine rng(18);
+    ThreadPool pool(1);
+    PopulationEvaluator evaluator(scenario.data, pool);
+    Population population = initializePopulation(12, scenario.data, rng);
+    evaluator.evaluate(population);
+    
+    vector<char> message = serializePopulation(population);
+    Population received(population.size(), population.getNumGenes());
+    if (deserializePopulation(message, received, 0) != population.size()) {
+        throw runtime_error("la poblacion no se leyo completa");
+    }
+    for (size_t i = 0; i < population.size(); i++) {
+        for (int c = 0; c < NUM_POLICIES; c++) {
+            if (!sameChromosome(population[i].chromosomes[c], received[i].chromosomes[c]) || received[i].chromosomes[c].dirty) {
+                throw runtime_error("individuo " + to_string(i) + ", " + policyNames[c] + " distinto");
+            }
+        }
     }
-    sort(points.begin(), points.end());
     
-    double hypervolume = 0.0;
-    double prevF1 = refPointF1;
+    vector<char> truncated(message.begin(), message.end() - 1);
+    expectFailure([&]() { deserializePopulation(truncated, received, 0); }, "el mensaje truncado");
+    expectFailure([&]() { deserializePopulation(message, received, 1); }, "el mensaje que no cabe");
+    vector<char> otherPolicy = message;
+    otherPolicy[sizeof(WireHeader)] = char(1);
+    expectFailure([&]() { deserializePopulation(otherPolicy, received, 0); }, "el cromosoma de otra politica");
     
-    for (const auto& point : points) {
-        double f1 = point.first;
-        double f2 = point.second;
-        
-        if (f1 < refPointF1 && f2 < refPointF2) {
-            hypervolume += (prevF1 - f1) * (refPointF2 - f2);
-            prevF1 = f1;
+    ParetoArchive archive(population.getNumGenes(), 64);
+    archive.update(population);
+    ParetoArchive merged(population.getNumGenes(), 64);
+    mergeArchiveMessage(serializeArchive(archive), merged);
+    for (int c = 0; c < NUM_POLICIES; c++) {
+        if (merged.size(c) != archive.size(c)) {
+            throw runtime_error("archivo de " + policyNames[c] + " con " + to_string(merged.size(c)) + " puntos en lugar de " +
+                                to_string(archive.size(c)));
+        }
+        for (size_t k = 0; k < archive.size(c); k++) {
+            if (!sameChromosome(archive.entry(c, k).chromosomes[c], merged.entry(c, k).chromosomes[c])) {
+                throw runtime_error("archivo de " + policyNames[c] + ": punto " + to_string(k) + " distinto");
+            }
         }
     }
-    return hypervolume;
 }
 
-Individual getKneePoint(const vector<Individual>& population) {
-    double refF1 = 0.0;
-    double refF2 = 0.0;
-    double minDistance = numeric_limits<double>::max();
-    Individual kneePoint;
-
-    for (const auto& ind : population) {
-        for (int c = 0; c < ind.getNumChromosomes(); c++) {
-            if (ind.chromosomes[c].domLevel == 1) {
-                double f1 = ind.chromosomes[c].f1;
-                double f2 = ind.chromosomes[c].f2;
-
-                double distance = sqrt(pow(refF2 - f2, 2) + pow(refF1 - f1, 2));
+/*
+ Con truncamiento (mu + lambda) el hipervolumen del primer frente de cada capa no baja
+ 
+ Los padres pasan intactos al truncamiento, asi que mientras el primer frente
+ de la poblacion combinada quepa completo, el nuevo primer frente domina al
+ anterior. Si llena toda la poblacion pudo recortarse por crowding, y esa
+ generacion no se revisa.
+ */
+void testTruncationKeepsFront() {
+    TestScenario scenario(22);
+    const int populationSize = 20;
+    RandomEngine rng(7);
+    ThreadPool pool(1);
+    PopulationEvaluator evaluator(scenario.data, pool);
+    Population population = initializePopulation(populationSize, scenario.data, rng, generationCapacity(populationSize));
+    Population nextPopulation(0, population.getNumGenes(), generationCapacity(populationSize));
+    evaluator.evaluate(population);
+    fastNonDominatedSort(population, &pool);
+    
+    double refF1 = 0;
+    double refF2 = 0;
+    for (const Individual& individual : population) {
+        for (const Chromosome& chromosome : individual.chromosomes) {
+            refF1 = max(refF1, chromosome.f1 + 50);
+            refF2 = max(refF2, chromosome.f2 + 50);
+        }
+    }
+    vector<double> previous(NUM_POLICIES);
+    for (int c = 0; c < NUM_POLICIES; c++) {
+        previous[c] = calculateHyperVolume(population, c, refF1, refF2);
+    }
+    for (int gen = 1; gen <= 60; gen++) {
+        geneticAlgorithmStep(population, nextPopulation, populationSize, rng, evaluator, pool, nullptr, SurvivorSelection::Truncation);
+        for (int c = 0; c < NUM_POLICIES; c++) {
+            double hv = calculateHyperVolume(population, c, refF1, refF2);
+            int frontSize = count_if(population.begin(), population.end(),
+                                     [c](const Individual& individual) { return individual.chromosomes[c].domLevel == 1; });
+            if (frontSize < populationSize && hv < previous[c] - 1e-9 * max(1.0, previous[c])) {
+                throw runtime_error("generacion " + to_string(gen) + ", " + policyNames[c] + ": el hipervolumen bajo de " +
+                                    to_string(previous[c]) + " a " + to_string(hv));
+            }
+            previous[c] = hv;
+        }
+    }
+}
 
-                if (distance < minDistance) {
-                    minDistance = distance;
-                    kneePoint = ind;
-                }
+/*
+ ContributionFronts y HypervolumeTracker coinciden con el calculo completo
+ 
+ Repite el reemplazo del modo estacionario (insertar, sacar el peor,
+ reubicar) sobre puntos con muchos empates y, despues de cada paso, compara
+ niveles y puntajes con assignDominanceLevels y el hipervolumen con
+ calculateHyperVolume. Entre puntos repetidos el puntaje depende de su
+ orden, asi que cada frente se compara como conjunto de (f1, f2, puntaje).
+ 
+ score: Puntaje de los frentes
+ */
+void checkIncrementalFronts(SteadyStateReplacement score) {
+    const int size = 40;
+    const double reference = 25;
+    RandomEngine rng(23);
+    Population population(size + 1, 1);
+    Population brute(size, 1);
+    auto randomPoint = [&rng](Chromosome& chromosome) {
+        chromosome.f1 = rng.nextBelow(30);
+        chromosome.f2 = rng.nextBelow(30);
+    };
+    
+    ContributionFronts fronts(population, 0, score);
+    HypervolumeTracker tracker(reference, reference);
+    fronts.track(&tracker);
+    for (int i = 0; i < size; i++) {
+        randomPoint(population[i].chromosomes[0]);
+        fronts.insert(i);
+    }
+    for (int step = 0; step <= 2000; step++) {
+        if (step > 0) {
+            randomPoint(population[size].chromosomes[0]);
+            fronts.insert(size);
+            int worst = fronts.worst();
+            fronts.remove(worst);
+            if (worst != size) {
+                population[worst].chromosomes[0].copyFrom(population[size].chromosomes[0]);
+                fronts.relabel(size, worst);
             }
         }
         
+        vector<vector<int>> levels;
+        for (int i = 0; i < size; i++) {
+            brute[i].chromosomes[0].f1 = population[i].chromosomes[0].f1;
+            brute[i].chromosomes[0].f2 = population[i].chromosomes[0].f2;
+        }
+        assignDominanceLevels(brute, 0, levels);
+        for (const vector<int>& level : levels) {
+            vector<tuple<double, double, double>> expected;
+            vector<tuple<double, double, double>> actual;
+            vector<int> sorted = level;
+            sort(sorted.begin(), sorted.end(), [&brute](int a, int b) {
+                const Chromosome& A = brute[a].chromosomes[0];
+                const Chromosome& B = brute[b].chromosomes[0];
+                return A.f1 < B.f1 || (A.f1 == B.f1 && A.f2 < B.f2);
+            });
+            const Chromosome& first = brute[sorted.front()].chromosomes[0];
+            const Chromosome& last = brute[sorted.back()].chromosomes[0];
+            for (size_t k = 0; k < sorted.size(); k++) {
+                const Chromosome& point = brute[sorted[k]].chromosomes[0];
+                double expectedScore = numeric_limits<double>::infinity();
+                if (k > 0 && k + 1 < sorted.size()) {
+                    const Chromosome& previous = brute[sorted[k - 1]].chromosomes[0];
+                    const Chromosome& next = brute[sorted[k + 1]].chromosomes[0];
+                    if (score == SteadyStateReplacement::Hypervolume) {
+                        expectedScore = (next.f1 - point.f1) * (previous.f2 - point.f2);
+                    } else {
+                        expectedScore = 0;
+                        if (last.f1 > first.f1) expectedScore += (next.f1 - previous.f1) / (last.f1 - first.f1);
+                        if (first.f2 > last.f2) expectedScore += (previous.f2 - next.f2) / (first.f2 - last.f2);
+                    }
+                }
+                expected.push_back(make_tuple(point.f1, point.f2, expectedScore));
+                const Chromosome& incremental = population[sorted[k]].chromosomes[0];
+                if (incremental.domLevel != point.domLevel) {
+                    throw runtime_error("paso " + to_string(step) + ": el nivel de " + to_string(sorted[k]) + " es " +
+                                        to_string(incremental.domLevel) + " y deberia ser " + to_string(point.domLevel));
+                }
+                actual.push_back(make_tuple(incremental.f1, incremental.f2, incremental.crowdingDistance));
+            }
+            sort(expected.begin(), expected.end());
+            sort(actual.begin(), actual.end());
+            if (expected != actual) {
+                throw runtime_error("paso " + to_string(step) + ": puntajes distintos en el frente " +
+                                    to_string(population[level[0]].chromosomes[0].domLevel));
+            }
+        }
+        const Chromosome& worst = population[fronts.worst()].chromosomes[0];
+        for (int index : levels.back()) {
+            if (population[index].chromosomes[0].crowdingDistance < worst.crowdingDistance) {
+                throw runtime_error("paso " + to_string(step) + ": worst no es el de menor puntaje");
+            }
+        }
+        double expectedVolume = calculateHyperVolume(brute, 0, reference, reference);
+        if (abs(tracker.hypervolume() - expectedVolume) > 1e-9 * max(1.0, expectedVolume)) {
+            throw runtime_error("paso " + to_string(step) + ": hipervolumen " + to_string(tracker.hypervolume()) +
+                                " y deberia ser " + to_string(expectedVolume));
+        }
     }
-    return kneePoint;
 }
 
-Individual getBestMakespan(const vector<Individual>& population) {
-    double bestMakespan = numeric_limits<double>::max();
-    Individual bestIndividual;
-
-    for (const auto& ind : population) {
-        for (int c = 0; c < ind.getNumChromosomes(); c++) {
-            if (ind.chromosomes[c].f1 < bestMakespan) {
-                bestMakespan = ind.chromosomes[c].f1;
-                bestIndividual = ind;
+/*
+ Un archivo de configuracion que se incluye a si mismo se rechaza en lugar de expandirse sin fin
+ */
+void testConfigIncludesItself() {
+    const string filename = TestScenario::testFileName("ciclo.cfg");
+    {
+        ofstream file(filename);
+        file << "seed 3\nconfig " << filename << "\n";
+    }
+    vector<string> args = {"--config", filename};
+    set<string> expanded;
+    string error;
+    try {
+        // Como en main: cada --config se expande al llegar a el
+        for (size_t i = 0; i < args.size() && i < 100; i++) {
+            if (args[i] == "--config") {
+                expandConfigFile(args[i + 1], args, i + 2, expanded);
+                i++;
             }
         }
+    } catch (const exception& e) {
+        error = e.what();
+    }
+    remove(filename.c_str());
+    if (error.empty()) {
+        throw runtime_error("la configuracion que se incluye a si misma no se rechazo");
     }
-    return bestIndividual;
 }
 
-Individual getBestEnergy(const vector<Individual>& population) {
-    double bestEnergy = numeric_limits<double>::max();
-    Individual bestIndividual;
+/*
+ El hipervolumen coincide con el calculado a mano sobre un frente chico
+ 
+ Con referencia (10, 10), el frente (2, 8), (4, 5), (7, 2) aporta las
+ franjas 8 * 2 + 6 * 3 + 3 * 3 = 43. El punto (5, 6) esta dominado por
+ (4, 5) y (12, 1) queda fuera de la caja: ninguno suma. Sin (4, 5) quedan
+ 8 * 2 + 3 * 6 = 34.
+ */
+void testHypervolumeByHand() {
+    const vector<pair<double, double>> points = {{5, 6}, {7, 2}, {12, 1}, {2, 8}, {4, 5}};
+    Population population(points.size(), 1);
+    for (size_t i = 0; i < points.size(); i++) {
+        population[i].chromosomes[0].f1 = points[i].first;
+        population[i].chromosomes[0].f2 = points[i].second;
+    }
+    vector<vector<int>> fronts;
+    assignDominanceLevels(population, 0, fronts);
+    
+    auto expect = [](const string& what, double value, double expected) {
+        if (abs(value - expected) > 1e-9) {
+            throw runtime_error(what + " da " + to_string(value) + " y deberia ser " + to_string(expected));
+        }
+    };
+    expect("calculateHyperVolume", calculateHyperVolume(population, 0, 10, 10), 43);
+    
+    HypervolumeTracker tracker(10, 10);
+    for (const auto& point : points) {
+        if (point != make_pair(5.0, 6.0)) tracker.add(point.first, point.second);
+    }
+    expect("HypervolumeTracker", tracker.hypervolume(), 43);
+    tracker.remove(4, 5);
+    expect("HypervolumeTracker sin (4, 5)", tracker.hypervolume(), 34);
+}
 
-    for (const auto& ind : population) {
-        for (int c = 0; c < ind.getNumChromosomes(); c++) {
-            if (ind.chromosomes[c].f2 < bestEnergy) {
-                bestEnergy = ind.chromosomes[c].f2;
-                bestIndividual = ind;
-            }
+/*
+ Ejecuta las pruebas internas e informa cada una
+ 
+ Lo que las pruebas imprimen (cargas, inicializaciones) se descarta.
+ int: 0 si todas pasan, 1 si alguna falla
+ */
+int runSelfTests() {
+    const vector<pair<string, function<void()>>> tests = {
+        {"truncamiento elitista sin perder hipervolumen", testTruncationKeepsFront},
+        {"frentes incrementales por contribucion contra el calculo completo",
+         []() { checkIncrementalFronts(SteadyStateReplacement::Hypervolume); }},
+        {"frentes incrementales por crowding contra el calculo completo",
+         []() { checkIncrementalFronts(SteadyStateReplacement::Crowding); }},
+        {"configuracion que se incluye a si misma", testConfigIncludesItself},
+        {"imagen binaria igual al escenario de texto", testBinaryMatchesText},
+        {"ida y vuelta por el formato entre procesos", testWireRoundTrip},
+        {"hipervolumen de un frente calculado a mano", testHypervolumeByHand},
+    };
+    int failures = 0;
+    for (const auto& test : tests) {
+        cout.setstate(ios::failbit);
+        try {
+            test.second();
+            cout.clear();
+            cout << "OK     " << test.first << endl;
+        } catch (const exception& e) {
+            cout.clear();
+            failures++;
+            cout << "FALLA  " << test.first << ": " << e.what() << endl;
         }
     }
-    return bestIndividual;
+    cout << tests.size() - failures << " de " << tests.size() << " pruebas correctas" << endl;
+    return failures == 0 ? 0 : 1;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    ProcessGroup processes(argc, argv);
     try {
-        int populationSize = 20;
-        int numGenerations = 100;
-        mt19937 rng(time(nullptr));
+        // Modo compilador: poliploides --compile <escenario.txt> <escenario.bin>
+        if (argc > 1 && string(argv[1]) == "--compile") {
+            if (argc != 4) {
+                cerr << "Uso: " << argv[0] << " --compile <escenario.txt> <escenario.bin>" << endl;
+                return 1;
+            }
+            ScenarioData scenario = loadScenarioText(argv[2]);
+            compileScenario(scenario, argv[3]);
+            cout << "Imagen binaria generada: " << argv[3] << endl;
+            return 0;
+        }
+        
+        // Pruebas internas: poliploides --self-test
+        if (argc > 1 && string(argv[1]) == "--self-test") {
+            return runSelfTests();
+        }
+        
+        RunConfig runConfig;
+        int numThreads = max(1u, thread::hardware_concurrency());
+        size_t cacheCapacity = 1 << 16;
+        int checkpointsPerChromosome = 0; // Cada checkpoint reserva un snapshot por evaluacion: solo a pedido
+        bool useBatches = false;
+        bool verbose = false;
+        bool useAsync = false;
+        bool usePipeline = false;
+        bool useSmsEmoa = false;
+        int archiveCapacity = 64;
+        SurvivorSelection survivorSelection = SurvivorSelection::Tournament;
+        uint64_t seed = uint64_t(time(nullptr));
+        IslandSettings islandSettings;
 
+        // Uso: poliploides [escenario] [--verbose] [--config archivo] [--seed N] [--threads N] [--cache N] [--checkpoints N] [--batch]
+        //                  [--async | --sms-emoa | --pipeline] [--archive N] [--survivors tournament|truncation]
+        //                  [--population N] [--generations N] [--evaluations N] [--deadline-ms N]
+        //                  [--stagnation N] [--stagnation-tolerance X] [--front-file archivo]
+        //                  [--islands N] [--migration-interval N] [--migrants N] [--topology ring|random]
+        //       mpirun -np N poliploides ... (compilado con -DPOLIPLOIDES_MPI; --islands es por proceso)
+        //       poliploides --self-test (pruebas internas)
+        // Con --front-file, SIGUSR1 escribe el frente actual al terminar la generacion en curso (sin islas).
         string filename = "escenario1.txt";
+        vector<string> args(argv + 1, argv + argc);
+        set<string> configFiles;
+        for (size_t i = 0; i < args.size(); i++) {
+            string arg = args[i];
+            if (arg == "--seed" && i + 1 < args.size()) {
+                seed = stoull(args[++i]);
+            } else if (arg == "--threads" && i + 1 < args.size()) {
+                numThreads = stoi(args[++i]);
+            } else if (arg == "--cache" && i + 1 < args.size()) {
+                cacheCapacity = stoull(args[++i]);
+            } else if (arg == "--checkpoints" && i + 1 < args.size()) {
+                checkpointsPerChromosome = stoi(args[++i]);
+            } else if (arg == "--batch") {
+                useBatches = true;
+            } else if (arg == "--verbose") {
+                verbose = true;
+            } else if (arg == "--async") {
+                useAsync = true;
+            } else if (arg == "--sms-emoa") {
+                useAsync = true;
+                useSmsEmoa = true;
+            } else if (arg == "--pipeline") {
+                usePipeline = true;
+            } else if (arg == "--archive" && i + 1 < args.size()) {
+                archiveCapacity = max(2, stoi(args[++i]));
+            } else if (arg == "--survivors" && i + 1 < args.size()) {
+                string mode = args[++i];
+                if (mode == "tournament") {
+                    survivorSelection = SurvivorSelection::Tournament;
+                } else if (mode == "truncation") {
+                    survivorSelection = SurvivorSelection::Truncation;
+                } else {
+                    throw runtime_error("ERROR: Seleccion de sobrevivientes desconocida: " + mode);
+                }
+            } else if (arg == "--config" && i + 1 < args.size()) {
+                expandConfigFile(args[i + 1], args, i + 2, configFiles);
+                i++;
+            } else if (arg == "--population" && i + 1 < args.size()) {
+                runConfig.populationSize = max(2, stoi(args[++i]));
+            } else if (arg == "--generations" && i + 1 < args.size()) {
+                runConfig.maxGenerations = max(0, stoi(args[++i]));
+            } else if (arg == "--evaluations" && i + 1 < args.size()) {
+                runConfig.maxEvaluations = max(0L, stol(args[++i]));
+            } else if (arg == "--deadline-ms" && i + 1 < args.size()) {
+                runConfig.deadlineMs = max(0, stoi(args[++i]));
+            } else if (arg == "--stagnation" && i + 1 < args.size()) {
+                runConfig.stagnationWindow = max(0, stoi(args[++i]));
+            } else if (arg == "--stagnation-tolerance" && i + 1 < args.size()) {
+                runConfig.stagnationTolerance = max(0.0, stod(args[++i]));
+            } else if (arg == "--front-file" && i + 1 < args.size()) {
+                runConfig.frontFile = args[++i];
+            } else if (arg == "--islands" && i + 1 < args.size()) {
+                islandSettings.numIslands = max(1, stoi(args[++i]));
+            } else if (arg == "--migration-interval" && i + 1 < args.size()) {
+                islandSettings.migrationInterval = max(0, stoi(args[++i]));
+            } else if (arg == "--migrants" && i + 1 < args.size()) {
+                islandSettings.migrantsPerLayer = max(1, stoi(args[++i]));
+            } else if (arg == "--topology" && i + 1 < args.size()) {
+                string topology = args[++i];
+                if (topology == "ring") {
+                    islandSettings.topology = MigrationTopology::Ring;
+                } else if (topology == "random") {
+                    islandSettings.topology = MigrationTopology::Random;
+                } else {
+                    throw runtime_error("ERROR: Topologia de migracion desconocida: " + topology);
+                }
+            } else {
+                filename = arg;
+            }
+        }
+        if ((useAsync || usePipeline) && (islandSettings.numIslands > 1 || processes.size() > 1)) {
+            throw runtime_error("ERROR: Los modos --async, --sms-emoa y --pipeline no se pueden combinar con islas");
+        }
+        if (useAsync && usePipeline) {
+            throw runtime_error("ERROR: Los modos estacionarios (--async, --sms-emoa) y --pipeline son excluyentes");
+        }
+        // Las islas migran en generaciones fijas: todas deben correr las mismas
+        if ((runConfig.deadlineMs > 0 || runConfig.stagnationWindow > 0 || runConfig.maxEvaluations > 0) &&
+            (islandSettings.numIslands > 1 || processes.size() > 1)) {
+            throw runtime_error("ERROR: --deadline-ms, --stagnation y --evaluations no se pueden combinar con islas");
+        }
+        
+        const int populationSize = runConfig.populationSize;
+        const int numGenerations = runConfig.maxGenerations;
+#ifdef SIGUSR1
+        if (!runConfig.frontFile.empty()) {
+            signal(SIGUSR1, requestFront);
+        }
+#endif
+        
+        // Solo el proceso 0 reporta
+        if (!processes.isRoot()) {
+            cout.setstate(ios::failbit);
+        }
         cout<<endl;
         printHeader("ALGORITMO GENETICO POLIPLOIDE",60);
         
         // Cargar escenario
-        ScenarioData scenario = loadScenario(filename);
+        ScenarioData scenario = loadScenario(filename, verbose);
+        
+        // El plazo corre desde aqui
+        RunController controller(runConfig);
+        
+        // Todo el azar de la corrida sale de esta semilla (--seed para repetirla)
+        cout << "Semilla: " << seed << endl;
+        if (runConfig.maxEvaluations > 0) {
+            cout << "Presupuesto: " << runConfig.maxEvaluations << " evaluaciones" << endl;
+        }
         
         // Calcular dimensiones
         int totalOps = calculateTotalOperations(scenario);
@@ -1490,76 +6321,201 @@ int main() {
         cout << "Numero de maquinas: " << scenario.numMachines << endl;
         cout << "Rango de genes: [1, " << scenario.numMachines << "]" << endl << endl;
         
-        // Crear una poblacion pequeña
-        
-        vector<Individual> population = initializePopulation(populationSize, scenario, rng);
-
-        printSubHeader("RESUMEN DE POBLACION INICIAL",50);
-        cout << "Tamano de poblacion: " << population.size() << endl;
-        cout << "Cromosomas por individuo: " << population[0].getNumChromosomes() << endl;
-        cout << "Genes por cromosoma: " << population[0].chromosomes[0].size() << endl;
-
-        vector<double> x_vals;
-        vector<double> y_vals;
-        vector<double> c; 
-
-        for (size_t i = 0; i < population.size(); i++){
-            string individuo = to_string(i+1);
-            evaluateAllPolicies(population[i], scenario, individuo, false, false);
-
+        ThreadPool pool(numThreads);
+        unique_ptr<FitnessCache> cache;
+        if (cacheCapacity > 0) {
+            cache.reset(new FitnessCache(cacheCapacity));
         }
-        graphPopulation(population);
-
-        double f1_max = population[0].chromosomes[0].f1;
-        double f2_max = population[0].chromosomes[0].f2;
-
-        for (auto& ind : population) {
-            for (auto& chrom : ind.chromosomes) {
-                if (chrom.f1 > f1_max) f1_max = chrom.f1;
-                if (chrom.f2 > f2_max) f2_max = chrom.f2;
+        int checkpointInterval = checkpointIntervalFor(scenario, checkpointsPerChromosome);
+        
+        // Punto de referencia del hipervolumen: peores valores de la poblacion inicial
+        double f1_max = 0;
+        double f2_max = 0;
+        auto setReferencePoint = [&f1_max, &f2_max](const Population& initial) {
+            f1_max = initial[0].chromosomes[0].f1;
+            f2_max = initial[0].chromosomes[0].f2;
+            for (auto& ind : initial) {
+                for (auto& chrom : ind.chromosomes) {
+                    if (chrom.f1 > f1_max) f1_max = chrom.f1;
+                    if (chrom.f2 > f2_max) f2_max = chrom.f2;
+                }
             }
-        }
-
-        f1_max += 50;
-        f2_max += 50;
-        fastNonDominatedSort(population);
-        vector<vector<double>> hypervolumes(population[0].getNumChromosomes());
-        for(int gen = 1; gen < numGenerations+1; gen++){
-            vector<Individual> new_population = geneticAlgorithmStep(population, scenario, populationSize, rng);
-            population = new_population;
-            for (int i=0; i<population[0].getNumChromosomes(); i++){
-                double hv = calculateHyperVolume(population, i, f1_max, f2_max);
-                hypervolumes[i].push_back(hv);
+            f1_max += 50;
+            f2_max += 50;
+        };
+        
+        // Mejores puntos de toda la corrida, por politica (para los reportes finales)
+        ParetoArchive archive(totalOps, archiveCapacity);
+        
+        Population population;
+        if (islandSettings.numIslands > 1 || processes.size() > 1) {
+            IslandModel islands(scenario, populationSize, seed, islandSettings, numThreads, cache.get(), checkpointInterval, useBatches, processes, archiveCapacity, survivorSelection);
+            cout << "Islas: " << islands.getTotalIslands();
+            if (processes.size() > 1) {
+                cout << " en " << processes.size() << " procesos";
+            }
+            cout << " (migracion cada " << islandSettings.migrationInterval
+                 << " generaciones, " << islandSettings.migrantsPerLayer << " emigrantes por capa, topologia "
+                 << (islandSettings.topology == MigrationTopology::Ring ? "anillo" : "aleatoria") << ", "
+                 << islands.getThreadsPerIsland() << " hilos por isla)" << endl;
+            Population initial = islands.mergePopulations();
+            if (processes.isRoot()) {
+                graphPopulation(initial);
+            }
+            setReferencePoint(initial);
+            f1_max = processes.maxAll(f1_max);
+            f2_max = processes.maxAll(f2_max);
+            
+            // Cada isla resume sus valores por tramo de 20 generaciones (uno por tabla):
+            // islandStatistics[(isla * numBlocks + tramo) * NUM_POLICIES + politica]
+            const int numBlocks = numGenerations / 20;
+            vector<RunningStatistics> islandStatistics(size_t(islands.getNumIslands()) * numBlocks * NUM_POLICIES);
+            islands.run(numGenerations, [&](int island, int gen, const Population& islandPopulation) {
+                if (gen > numBlocks * 20) return;
+                RunningStatistics* block = &islandStatistics[(size_t(island) * numBlocks + (gen - 1) / 20) * NUM_POLICIES];
+                for (int i = 0; i < NUM_POLICIES; i++) {
+                    block[i].add(calculateHyperVolume(islandPopulation, i, f1_max, f2_max));
+                }
+            });
+            
+            // El proceso 0 junta los resumenes de todas las islas (en orden de rank)
+            if (processes.size() > 1) {
+                vector<char> local(reinterpret_cast<const char*>(islandStatistics.data()),
+                                   reinterpret_cast<const char*>(islandStatistics.data() + islandStatistics.size()));
+                vector<vector<char>> messages = processes.gatherToRoot(local);
+                islandStatistics.clear();
+                for (const auto& message : messages) {
+                    if (message.size() != local.size()) {
+                        throw runtime_error("ERROR: Resumen de hipervolumen de tamano inesperado: " + to_string(message.size()) + " bytes");
+                    }
+                    const RunningStatistics* received = reinterpret_cast<const RunningStatistics*>(message.data());
+                    islandStatistics.insert(islandStatistics.end(), received, received + message.size() / sizeof(RunningStatistics));
+                }
+            }
+            vector<RunningStatistics> statistics(NUM_POLICIES);
+            for (int block = 0; block < numBlocks && processes.isRoot(); block++) {
+                for (int island = 0; island < islands.getTotalIslands(); island++) {
+                    for (int i = 0; i < NUM_POLICIES; i++) {
+                        statistics[i].merge(islandStatistics[(size_t(island) * numBlocks + block) * NUM_POLICIES + i]);
+                    }
+                }
+                printHypervolumeTable((block + 1) * 20, statistics);
+            }
+            islands.collectArchive(archive);
+            population = islands.mergePopulations();
+            if (!processes.isRoot()) {
+                return 0;
             }
-            if (gen % 20 == 0){
-                printHeader("GENERACION " + to_string(gen), 50);
-                vector<vector<string>> hvTableValues;
-                vector<string> hvTableFields = {"Politica", "Min", "Max", "Promedio"};
+            fastNonDominatedSort(population, &pool);
+        } else {
+            RandomEngine rng(seed);
+            population = initializePopulation(populationSize, scenario, rng, generationCapacity(populationSize));
+            Population nextPopulation(0, population.getNumGenes(), generationCapacity(populationSize));
+
+            printSubHeader("RESUMEN DE POBLACION INICIAL",50);
+            cout << "Tamano de poblacion: " << population.size() << endl;
+            cout << "Cromosomas por individuo: " << population[0].getNumChromosomes() << endl;
+            cout << "Genes por cromosoma: " << population[0].chromosomes[0].size() << endl;
+
+            PopulationEvaluator evaluator(scenario, pool, cache.get(), checkpointInterval, useBatches);
+            cout << "Hilos de evaluacion: " << pool.size() << endl;
+            evaluator.evaluate(population);
+            archive.update(population);
+            graphPopulation(population);
+            setReferencePoint(population);
+            // Primer frente de cada capa, ya ordenado por f1, que deja la ultima clasificacion
+            vector<vector<int>> firstFronts;
+            fastNonDominatedSort(population, &pool, &firstFronts);
+            
+            // El modo estacionario lleva el hipervolumen al dia; los generacionales reordenan toda la
+            // poblacion en cada generacion y suman las franjas de los frentes que dejo esa clasificacion
+            function<double(int)> layerHypervolume = [&](int i) {
+                return frontHypervolume(population, i, firstFronts[i], f1_max, f2_max);
+            };
+            // Evaluaciones de la corrida: la poblacion inicial mas las del modo elegido
+            function<long()> evaluations = [&evaluator]() { return evaluator.getEvaluations(); };
+            vector<RunningStatistics> statistics(population[0].getNumChromosomes());
+            vector<double> currentHypervolumes(population[0].getNumChromosomes());
+            auto recordGeneration = [&](int gen) {
                 for (int i=0; i<population[0].getNumChromosomes(); i++){
-                    int minVal = *min_element(hypervolumes[i].begin(), hypervolumes[i].end());
-                    int maxVal = *max_element(hypervolumes[i].begin(), hypervolumes[i].end());
-                    double mean = accumulate(hypervolumes[i].begin(), hypervolumes[i].end(), 0.0) / hypervolumes[i].size();
-                    vector<string> row;
-                    row.push_back(population[0].chromosomes[i].policyName);
-                    row.push_back(to_string(minVal));
-                    row.push_back(to_string(maxVal));
-                    row.push_back(to_string(mean));
-                    hvTableValues.push_back(row);
+                    currentHypervolumes[i] = layerHypervolume(i);
+                    statistics[i].add(currentHypervolumes[i]);
+                }
+                if (gen % 20 == 0){
+                    printHypervolumeTable(gen, statistics);
+                }
+                if (frontRequested) {
+                    frontRequested = 0;
+                    writeParetoFront(archive, runConfig.frontFile);
+                }
+                if (controller.shouldContinue(gen, currentHypervolumes, evaluations())) {
+                    return true;
+                }
+                if (gen % 20 != 0) {
+                    printHypervolumeTable(gen, statistics);
+                }
+                if (gen < numGenerations) {
+                    cout << "Corrida detenida en la generacion " << gen << " (" << controller.getStopReason()
+                         << ", " << controller.elapsedMs() << " ms)" << endl;
+                }
+                return false;
+            };
+            if (useAsync) {
+                // Sin barrera por generacion: una "generacion" son populationSize hijos insertados
+                SteadyStateEngine engine(scenario, population, rng, numThreads, cache.get(), checkpointInterval, &archive,
+                                         useSmsEmoa ? SteadyStateReplacement::Hypervolume : SteadyStateReplacement::Crowding);
+                cout << "Modo estacionario asincrono (" << max(1, numThreads) - 1 << " trabajadores"
+                     << (useSmsEmoa ? ", reemplazo por contribucion al hipervolumen" : "") << ")" << endl;
+                engine.trackHypervolume(f1_max, f2_max);
+                layerHypervolume = [&engine](int i) { return engine.hypervolume(i); };
+                evaluations = [&]() { return evaluator.getEvaluations() + engine.getEvaluations(); };
+                long inserted = engine.run(numGenerations, recordGeneration,
+                                           [&]() { return !controller.exhausted(evaluations()); });
+                if (inserted % populationSize != 0) {
+                    int gen = inserted / populationSize;
+                    if (gen > 0 && gen % 20 != 0) {
+                        printHypervolumeTable(gen, statistics);
+                    }
+                    cout << "Corrida detenida en la generacion " << gen + 1 << ", tras " << inserted % populationSize
+                         << " de " << populationSize << " hijos (" << controller.getStopReason() << ", "
+                         << controller.elapsedMs() << " ms)" << endl;
+                }
+            } else if (usePipeline) {
+                GenerationPipeline pipeline(scenario, populationSize, pool, numThreads, cache.get(), checkpointInterval, survivorSelection);
+                evaluations = [&]() { return evaluator.getEvaluations() + pipeline.getEvaluations(); };
+                for(int gen = 1; gen < numGenerations+1; gen++){
+                    pipeline.step(population, nextPopulation, rng, &archive, &firstFronts);
+                    if (!recordGeneration(gen)) break;
+                }
+            } else {
+                for(int gen = 1; gen < numGenerations+1; gen++){
+                    geneticAlgorithmStep(population, nextPopulation, populationSize, rng, evaluator, pool, &archive, survivorSelection, &firstFronts);
+                    if (!recordGeneration(gen)) break;
                 }
-                printTable(hvTableFields, hvTableValues);
             }
         }
+        if (cache) {
+            uint64_t lookups = cache->getHits() + cache->getMisses();
+            printSubHeader("CACHE DE FITNESS", 50);
+            printTable({"Consultas", "Aciertos", "Fallos", "Tasa de aciertos"},
+                       {{to_string(lookups), to_string(cache->getHits()), to_string(cache->getMisses()),
+                         to_string(lookups > 0 ? 100.0 * cache->getHits() / lookups : 0.0) + " %"}});
+        }
+        if (!runConfig.frontFile.empty()) {
+            writeParetoFront(archive, runConfig.frontFile);
+        }
         graphPopulation(population);
-        graphParetoFront(population);
-        Individual kneePoint = getKneePoint(population);
+        graphParetoFront(archive);
+        Individual& kneePoint = getKneePoint(archive);
         evaluateAllPolicies(kneePoint, scenario, "Rodilla", true, true);
-        Individual bestMakespan = getBestMakespan(population);
+        Individual& bestMakespan = getBestMakespan(archive);
         evaluateAllPolicies(bestMakespan, scenario, "Mejor Makespan", true, true);
-        Individual bestEnergy = getBestEnergy(population);
+        Individual& bestEnergy = getBestEnergy(archive);
         evaluateAllPolicies(bestEnergy, scenario, "Mejor Energia", true, true);
         
     } catch (const exception& e) {
         cerr << "EXCEPCION: " << e.what() << endl;
+        processes.abortAll();
         return 1;
     }
     return 0;